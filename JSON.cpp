@@ -1,19 +1,27 @@
 #include "JSON.hpp"
 
+#include <algorithm>
 #include <charconv>
+#include <cstring>
 
 #define PUT_VARIANT(var)\
+if (valueSchema != nullptr && !CheckSchema(var, *valueSchema))\
+	return false;\
 uint16_t containerType = toContainer.GetType();\
 if (containerType == Variant::Dictionary) {\
 	std::unordered_map<std::string, Variant>& map = *(std::unordered_map<std::string, Variant>*)toContainer.GetData();\
 	map[currentKey] = std::move(var);\
 	expectingKey = true;\
 }\
-else {\
+else if (containerType == Variant::VariantArray) {\
 	std::vector<Variant>& vector = *(std::vector<Variant>*)toContainer.GetData();\
 	vector.push_back(std::move(var));\
 	expectingKey = false;\
 }\
+else {\
+	PutPacked(toContainer, var);\
+	expectingKey = false;\
+}\
 
 
 std::string JSON::ToJSON(const std::unordered_map<std::string, Variant>& map, bool prettyPrint) {
@@ -50,6 +58,172 @@ std::unordered_map<std::string, Variant> JSON::ParseJSON(const std::string& stri
 	return std::move(map);
 }
 
+std::unordered_map<std::string, Variant> JSON::ParseJSON(const std::string& string, const Projection& projection) {
+
+	size_t i;
+	for (i = 0; i < string.size(); ++i) {
+		const uint8_t c = string[i];
+		if (c == '{') {
+			++i; //Skip it
+			break;
+		}
+	}
+
+	std::unordered_map<std::string, Variant> map;
+
+	Variant variant = (std::unordered_map<std::string, Variant>*)&map;
+	ParseValue(variant, string, i, projection.root.leaf ? nullptr : &projection.root);
+
+	return map;
+}
+
+void JSON::ParseInto(std::unordered_map<std::string, Variant>& map, const std::string& string) {
+
+	size_t i;
+	for (i = 0; i < string.size(); ++i) {
+		const uint8_t c = string[i];
+		if (c == '{') {
+			++i; //Skip it
+			break;
+		}
+	}
+
+	Variant variant = &map;
+	ParseValueInto(variant, string, i);
+}
+
+JSON::Projection::Projection(const std::vector<std::string>& paths) {
+
+	for (const std::string& path : paths) {
+		if (path.empty()) { //Whole document
+			root.leaf = true;
+			continue;
+		}
+
+		Node* node = &root;
+		size_t i = 1;
+		while (i <= path.size()) {
+			size_t end = path.find('/', i);
+			if (end == std::string::npos)
+				end = path.size();
+
+			std::string key;
+			UnescapePointerToken(std::string_view(path).substr(i, end - i), key);
+
+			Node* child = nullptr;
+			for (Node& existing : node->children) {
+				if (existing.key == key) {
+					child = &existing;
+					break;
+				}
+			}
+
+			if (child == nullptr) {
+				node->children.emplace_back();
+				child = &node->children.back();
+				child->key = std::move(key);
+			}
+
+			node = child;
+			i = end + 1;
+		}
+
+		node->leaf = true;
+	}
+
+	root.Sort();
+}
+
+const JSON::Projection::Node* JSON::Projection::Node::Find(const std::string_view& name) const {
+
+	auto it = std::lower_bound(children.begin(), children.end(), name, [](const Node& child, const std::string_view& name) {
+		return child.key < name;
+	});
+
+	if (it != children.end() && it->key == name)
+		return &*it;
+
+	return wildcard != SIZE_MAX ? &children[wildcard] : nullptr;
+}
+
+const JSON::Projection::Node* JSON::Projection::Node::Find(size_t element) const {
+
+	char name[20];
+	const std::to_chars_result result = std::to_chars(name, name + sizeof(name), element);
+
+	return Find(std::string_view(name, result.ptr - name));
+}
+
+void JSON::Projection::Node::Sort() {
+
+	std::sort(children.begin(), children.end(), [](const Node& a, const Node& b) {
+		return a.key < b.key;
+	});
+
+	for (size_t i = 0; i < children.size(); ++i) {
+		const std::string& key = children[i].key;
+		if (key == "*")
+			wildcard = i;
+		else if (!key.empty() && (key[0] != '0' || key.size() == 1) && std::all_of(key.begin(), key.end(), [](char c) { return c >= '0' && c <= '9'; })) //Leading zeros aren't array indices
+			indexed = true;
+
+		children[i].Sort();
+	}
+}
+
+Variant* JSON::Find(std::unordered_map<std::string, Variant>& map, const Key& key) {
+	return (Variant*)Find((const std::unordered_map<std::string, Variant>&)map, key);
+}
+
+const Variant* JSON::Find(const std::unordered_map<std::string, Variant>& map, const Key& key) {
+
+	//std::unordered_map has no heterogeneous lookup in C++17, so the key is copied into a per thread buffer that keeps its capacity between lookups
+	thread_local std::string lookupKey;
+	lookupKey.assign(key.GetName().data(), key.GetName().size());
+
+	auto it = map.find(lookupKey);
+	if (it == map.end())
+		return nullptr;
+
+	return &it->second;
+}
+
+const Variant* JSON::Find(const Variant& dictionary, const Key& key) {
+
+	if (dictionary.GetType() != Variant::Dictionary)
+		return nullptr;
+
+	return Find(*(std::unordered_map<std::string, Variant>*)dictionary.GetData(), key);
+}
+
+void JSON::GetKeys(const std::unordered_map<std::string, Variant>& map, const Key* keys, const Variant** results, size_t count) {
+
+	for (size_t i = 0; i < count; ++i)
+		results[i] = nullptr;
+
+	if (map.size() > count * 4) { //Big dictionaries: hashed lookups per key
+		for (size_t i = 0; i < count; ++i)
+			results[i] = Find(map, keys[i]);
+
+		return;
+	}
+
+	//Small dictionaries (Most glTF/scene objects): a single walk over the elements comparing lengths first is cheaper than hashing every key
+	size_t remaining = count;
+	for (auto& element : map) {
+		for (size_t i = 0; i < count; ++i) {
+			const std::string_view& name = keys[i].GetName();
+			if (results[i] == nullptr && element.first.size() == name.size() && memcmp(element.first.data(), name.data(), name.size()) == 0) {
+				results[i] = &element.second;
+				--remaining;
+			}
+		}
+
+		if (remaining == 0)
+			break;
+	}
+}
+
 template <bool PrettyPrint>
 void JSON::WriteValue(const Variant& variant, std::string& string, uint32_t indentation) {
 
@@ -197,44 +371,149 @@ void JSON::WriteValue(const Variant& variant, std::string& string, uint32_t inde
 		break;
 	}
 
+	case Variant::BoolArray: { //Packed arrays (Example: From schema parsing) are written as variant arrays
+		auto& vector = *(std::vector<bool>*)variant.GetData();
+		std::vector<Variant> converted(vector.size());
+		for (size_t i = 0; i < vector.size(); ++i)
+			converted[i] = bool(vector[i]);
+
+		WriteValue<PrettyPrint>(Variant(std::move(converted)), string, indentation);
+		break;
+	}
+
+	case Variant::ByteArray: {
+		auto& vector = *(std::vector<uint8_t>*)variant.GetData();
+		std::vector<Variant> converted(vector.size());
+		for (size_t i = 0; i < vector.size(); ++i)
+			converted[i] = (int64_t)vector[i];
+
+		WriteValue<PrettyPrint>(Variant(std::move(converted)), string, indentation);
+		break;
+	}
+
+	case Variant::IntArray: {
+		auto& vector = *(std::vector<int64_t>*)variant.GetData();
+		std::vector<Variant> converted(vector.size());
+		for (size_t i = 0; i < vector.size(); ++i)
+			converted[i] = vector[i];
+
+		WriteValue<PrettyPrint>(Variant(std::move(converted)), string, indentation);
+		break;
+	}
+
+	case Variant::FloatArray: {
+		auto& vector = *(std::vector<double>*)variant.GetData();
+		std::vector<Variant> converted(vector.size());
+		for (size_t i = 0; i < vector.size(); ++i)
+			converted[i] = vector[i];
+
+		WriteValue<PrettyPrint>(Variant(std::move(converted)), string, indentation);
+		break;
+	}
+
+	case Variant::StringArray: {
+		auto& vector = *(std::vector<std::string>*)variant.GetData();
+		std::vector<Variant> converted(vector.size());
+		for (size_t i = 0; i < vector.size(); ++i)
+			converted[i] = vector[i];
+
+		WriteValue<PrettyPrint>(Variant(std::move(converted)), string, indentation);
+		break;
+	}
+
 	default:
 		break;
 	}
 }
 
 
-void JSON::ParseValue(Variant& toContainer, const std::string& string, size_t& index) {
+bool JSON::ParseValue(Variant& toContainer, const std::string_view& string, size_t& index, const Projection::Node* projection, const Schema::Node* schema) {
 
 	std::string currentKey = "";
 	bool expectingKey = toContainer.GetType() == Variant::Dictionary;
 
+	//Schema of the next value, nullptr accepts anything
+	const Schema::Node* valueSchema = nullptr;
+	if (schema != nullptr && !expectingKey && !schema->items.empty())
+		valueSchema = &schema->items[0];
+
+	//Projection of the next nested value, nullptr keeps everything
+	const Projection::Node* childProjection = nullptr;
+	bool skipElements = false;
+	const bool matchElements = projection != nullptr && !expectingKey && projection->indexed; //Array elements matched one by one on their index
+	bool elementStart = true;
+	size_t element = 0;
+	if (projection != nullptr && !expectingKey && !matchElements) { //Only a wildcard can match array elements, decided once for all of them
+		childProjection = projection->Find("*");
+		skipElements = childProjection == nullptr;
+		if (childProjection != nullptr && childProjection->leaf)
+			childProjection = nullptr;
+	}
+
 	while (true) {
+		if (skipElements) {
+			SkipValue(string, index);
+		}
+		else if (matchElements && elementStart) {
+			elementStart = false;
+
+			const Projection::Node* child = projection->Find(element++);
+			if (child == nullptr)
+				SkipValue(string, index);
+			else
+				childProjection = child->leaf ? nullptr : child;
+		}
+
 		std::string_view token;
 		GetToken(string, index, token);
 		if (token.empty())
 			break;
 
-		if (token[0] == '"') { //Strings
-			std::string escapedString;
-			escapedString.reserve(token.size() - 2); //-2 since we ignore quotes
-
-			for (size_t i = 1; i < token.size() - 1; ++i) { //Start at 1 and -1 size to remove quotes
-				const uint8_t character = token[i];
-				if (character == '\\' && i < token.size() - 2 && token[i + 1] == '"') {
+		if (token[0] == '"' && expectingKey) { //Keys
+			currentKey.clear();
+			expectingKey = false;
+
+			if (projection != nullptr) {
+				//Matched on the raw token, only keys with escapes are unescaped before knowing if they're kept
+				const std::string_view rawKey = token.substr(1, token.size() - 2);
+				const bool escaped = rawKey.find('\\') != std::string_view::npos;
+				if (escaped)
+					UnescapeString(token, currentKey);
+
+				const Projection::Node* child = projection->Find(escaped ? std::string_view(currentKey) : rawKey);
+				if (child == nullptr) { //Not projected, skip its value
+					SkipValue(string, index);
+					expectingKey = true;
 					continue;
 				}
-				escapedString.push_back(character);
-			}
 
-			if (expectingKey) {
-				currentKey = escapedString;
-				expectingKey = false;
+				childProjection = child->leaf ? nullptr : child;
+				if (!escaped)
+					currentKey.assign(rawKey.data(), rawKey.size());
 			}
 			else {
-				Variant variant = escapedString;
-				PUT_VARIANT(variant);
+				UnescapeString(token, currentKey);
 			}
 
+			if (schema != nullptr)
+				valueSchema = schema->FindProperty(currentKey);
+
+			continue;
+		}
+
+		if (childProjection != nullptr && (token[0] == '"' || token[0] == 't' || token[0] == 'f' || token[0] == 'n' || isdigit(token[0]) || token[0] == '-')) { //Scalar where the projection expects a container, nothing in it can match
+			expectingKey = toContainer.GetType() == Variant::Dictionary;
+			continue;
+		}
+
+		if (token[0] == '"') { //Strings
+			std::string escapedString;
+			escapedString.reserve(token.size() - 2); //-2 since we ignore quotes
+			UnescapeString(token, escapedString);
+
+			Variant variant = std::move(escapedString);
+			PUT_VARIANT(variant);
+
 			continue;
 		}
 
@@ -257,23 +536,13 @@ void JSON::ParseValue(Variant& toContainer, const std::string& string, size_t& i
 		}
 
 		if (isdigit(token[0]) || token[0] == '-') { //Numbers: Check for minus '-' too for negative numbers
-			bool isInteger = true;
-			for (const uint8_t character : token) {
-				if (character == '.' || character == 'e') {
-					isInteger = false;
-					break;
-				}
-			}
-
-			if (isInteger) {
-				int64_t integer = 0;
-				std::from_chars(token.data(), token.data() + token.size(), integer);
+			int64_t integer;
+			double number;
+			if (ParseNumber(token, integer, number)) {
 				Variant variant = integer;
 				PUT_VARIANT(variant);
 			}
 			else {
-				double number = 0.0;
-				std::from_chars(token.data(), token.data() + token.size(), number);
 				Variant variant = number;
 				PUT_VARIANT(variant);
 			}
@@ -282,15 +551,35 @@ void JSON::ParseValue(Variant& toContainer, const std::string& string, size_t& i
 		}
 
 		if (token[0] == '{') { //if (token == "{") {
+			if (valueSchema != nullptr && !(valueSchema->types & Schema::ObjectType)) //Abort before parsing it
+				return false;
+
 			Variant variant = std::unordered_map<std::string, Variant>();
-			ParseValue(variant, string, index);
+			if (!ParseValue(variant, string, index, childProjection, valueSchema))
+				return false;
+
+			if (childProjection != nullptr && ((std::unordered_map<std::string, Variant>*)variant.GetData())->empty()) { //None of the projected fields were in it
+				expectingKey = toContainer.GetType() == Variant::Dictionary;
+				continue;
+			}
+
 			PUT_VARIANT(variant);
 			continue;
 		}
 
 		if (token[0] == '[') { //if (token == "[") {
-			Variant variant = std::vector<Variant>();
-			ParseValue(variant, string, index);
+			if (valueSchema != nullptr && !(valueSchema->types & Schema::ArrayType))
+				return false;
+
+			Variant variant = valueSchema != nullptr ? MakeArray(*valueSchema) : Variant(std::vector<Variant>());
+			if (!ParseValue(variant, string, index, childProjection, valueSchema))
+				return false;
+
+			if (childProjection != nullptr && ((std::vector<Variant>*)variant.GetData())->empty()) {
+				expectingKey = toContainer.GetType() == Variant::Dictionary;
+				continue;
+			}
+
 			PUT_VARIANT(variant);
 			continue;
 		}
@@ -302,8 +591,375 @@ void JSON::ParseValue(Variant& toContainer, const std::string& string, size_t& i
 		if (token[0] == ']') { //if (token == "]") {
 			break;
 		}
+
+		if (token[0] == ',')
+			elementStart = true;
 	}
 
+	if (schema != nullptr && toContainer.GetType() == Variant::Dictionary) {
+		auto& map = *(std::unordered_map<std::string, Variant>*)toContainer.GetData();
+		for (const std::string& required : schema->required) {
+			if (map.find(required) == map.end())
+				return false;
+		}
+	}
+
+	return true;
+}
+
+
+void JSON::SkipValue(const std::string_view& string, size_t& index) {
+
+	size_t depth = 0;
+	bool started = false; //A scalar ends on the first delimiter, a container on its matching closing character
+
+	for (; index < string.size(); ++index) {
+		const uint8_t character = string[index];
+
+		switch (character) {
+
+		case '"': {
+			for (++index; index < string.size(); ++index) {
+				if (string[index] == '\\')
+					++index;
+				else if (string[index] == '"')
+					break;
+			}
+
+			started = true;
+			if (depth == 0) {
+				++index;
+				return;
+			}
+
+			break;
+		}
+
+		case '{':
+		case '[':
+			++depth;
+			started = true;
+			break;
+
+		case '}':
+		case ']':
+			if (depth == 0) //End of the enclosing container, left for the caller
+				return;
+
+			if (--depth == 0) {
+				++index;
+				return;
+			}
+
+			break;
+
+		case ',':
+			if (depth == 0)
+				return;
+
+			break;
+
+		case ':':
+			if (depth == 0 && started)
+				return;
+
+			break;
+
+		case ' ': case '\t': case '\n': case '\r': case '\v': case '\f':
+			if (depth == 0 && started)
+				return;
+
+			break;
+
+#ifdef JSON_COMMENT_EXTENSION
+		case '/': {
+			if (index + 1 >= string.size())
+				break;
+
+			if (string[index + 1] == '/') {
+				const size_t end = string.find('\n', index);
+				index = end == std::string_view::npos ? string.size() - 1 : end;
+			}
+			else if (string[index + 1] == '*') {
+				const size_t end = string.find("*/", index + 2);
+				index = end == std::string_view::npos ? string.size() - 1 : end + 1;
+			}
+			else {
+				started = true;
+			}
+
+			break;
+		}
+#endif
+
+		default:
+			started = true;
+			break;
+		}
+	}
+}
+
+
+void JSON::ParseValueInto(Variant& toContainer, const std::string_view& string, size_t& index) {
+
+	//Same grammar as ParseValue, but values are written over the existing ones reusing their heap data when the type matches
+	const bool isDictionary = toContainer.GetType() == Variant::Dictionary;
+	auto& map = *(std::unordered_map<std::string, Variant>*)toContainer.GetData();
+	auto& vector = *(std::vector<Variant>*)toContainer.GetData();
+
+	//Per thread so their capacity survives between parses, seenValues is used as a stack by the recursion
+	thread_local std::string currentKey;
+	thread_local std::vector<const Variant*> seenValues;
+
+	const size_t seenStart = seenValues.size();
+	size_t elementCount = 0;
+	Variant* slot = nullptr; //Where the next value is written, for dictionaries it's set by the preceding key
+
+	while (true) {
+		std::string_view token;
+		GetToken(string, index, token);
+		if (token.empty())
+			break;
+
+		const uint8_t character = token[0];
+
+		if (character == '}' || character == ']')
+			break;
+
+		if (character == ',' || character == ':')
+			continue;
+
+		if (isDictionary && slot == nullptr) {
+			if (character != '"') //Not a key
+				continue;
+
+			currentKey.clear();
+			UnescapeString(token, currentKey);
+
+			auto it = map.find(currentKey);
+			if (it == map.end())
+				it = map.emplace(currentKey, Variant()).first;
+
+			slot = &it->second;
+			seenValues.push_back(slot);
+			continue;
+		}
+
+		if (!isDictionary) {
+			if (elementCount == vector.size())
+				vector.emplace_back();
+
+			slot = &vector[elementCount++];
+		}
+
+		//Heap data is only reused if owned, else it could be a dangling moved from pointer
+		const bool reusable = slot->OwnsData();
+
+		if (character == '"') {
+			if (slot->GetType() == Variant::String && reusable) {
+				std::string& existing = *(std::string*)slot->GetData();
+				existing.clear();
+				UnescapeString(token, existing);
+			}
+			else {
+				std::string escapedString;
+				escapedString.reserve(token.size() - 2);
+				UnescapeString(token, escapedString);
+				*slot = std::move(escapedString);
+			}
+		}
+		else if (character == 't') {
+			*slot = true;
+		}
+		else if (character == 'f') {
+			*slot = false;
+		}
+		else if (character == 'n') {
+			*slot = (void*)nullptr;
+		}
+		else if (isdigit(character) || character == '-') {
+			int64_t integer;
+			double number;
+			if (ParseNumber(token, integer, number))
+				*slot = integer;
+			else
+				*slot = number;
+		}
+		else if (character == '{') {
+			if (slot->GetType() != Variant::Dictionary || !reusable)
+				*slot = std::unordered_map<std::string, Variant>();
+
+			ParseValueInto(*slot, string, index);
+		}
+		else if (character == '[') {
+			if (slot->GetType() != Variant::VariantArray || !reusable)
+				*slot = std::vector<Variant>();
+
+			ParseValueInto(*slot, string, index);
+		}
+		else if (!isDictionary) { //Unknown token, give the element back
+			--elementCount;
+		}
+
+		if (isDictionary)
+			slot = nullptr;
+	}
+
+	if (isDictionary) {
+		//Erase the keys that weren't in the new document
+		auto seenBegin = seenValues.begin() + seenStart;
+		std::sort(seenBegin, seenValues.end());
+		const size_t seenCount = std::unique(seenBegin, seenValues.end()) - seenBegin;
+
+		if (seenCount < map.size()) {
+			for (auto it = map.begin(); it != map.end();) {
+				if (std::binary_search(seenBegin, seenBegin + seenCount, (const Variant*)&it->second))
+					++it;
+				else
+					it = map.erase(it);
+			}
+		}
+
+		seenValues.resize(seenStart);
+	}
+	else {
+		vector.erase(vector.begin() + elementCount, vector.end()); //Keeps the capacity
+	}
+}
+
+
+void JSON::UnescapeString(const std::string_view& token, std::string& string) { //Appends
+
+	for (size_t i = 1; i < token.size() - 1; ++i) { //Start at 1 and -1 size to remove quotes
+		const uint8_t character = token[i];
+		if (character == '\\' && i < token.size() - 2 && token[i + 1] == '"') {
+			continue;
+		}
+		string.push_back(character);
+	}
+}
+
+bool JSON::ParseNumber(const std::string_view& token, int64_t& integer, double& number) {
+
+	//Classifies and converts in a single pass, falling back to std::from_chars (Exact) only for what the fast paths can't represent
+	const char* character = token.data();
+	const char* end = character + token.size();
+
+	const bool negative = character != end && *character == '-';
+	if (negative)
+		++character;
+
+	uint64_t mantissa = 0; //Wraps past 19 digits, only trusted when digitCount <= 19
+	const char* integerStart = character;
+	ParseDigits(character, end, mantissa);
+	size_t digitCount = character - integerStart;
+
+	bool isInteger = true;
+	int64_t exponent = 0;
+
+	if (character != end && *character == '.') {
+		isInteger = false;
+		++character;
+
+		const char* fractionStart = character;
+		ParseDigits(character, end, mantissa);
+		digitCount += character - fractionStart;
+		exponent = -(int64_t)(character - fractionStart);
+	}
+
+	if (character != end && (*character == 'e' || *character == 'E')) {
+		isInteger = false;
+		++character;
+
+		bool negativeExponent = false;
+		if (character != end && (*character == '-' || *character == '+')) {
+			negativeExponent = *character == '-';
+			++character;
+		}
+
+		int64_t explicitExponent = 0;
+		for (; character != end && (uint8_t)(*character - '0') < 10; ++character) {
+			if (explicitExponent < 100000) //Clamp, anything past this is already zero or infinity
+				explicitExponent = explicitExponent * 10 + (*character - '0');
+		}
+
+		exponent += negativeExponent ? -explicitExponent : explicitExponent;
+	}
+
+	if (isInteger) {
+		if (digitCount <= 19) { //Can't have wrapped
+			if (negative && mantissa <= (uint64_t)INT64_MAX + 1) {
+				integer = (int64_t)(0 - mantissa);
+				return true;
+			}
+
+			if (!negative && mantissa <= (uint64_t)INT64_MAX) {
+				integer = (int64_t)mantissa;
+				return true;
+			}
+		}
+
+		//Overflowing integers become doubles instead of being truncated, below
+	}
+
+	//Clinger's fast path: both the mantissa and the power of ten are exact doubles, so a single multiplication or division is correctly rounded
+	static constexpr double powersOfTen[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	if (digitCount <= 19 && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+		double value = (double)mantissa;
+		if (exponent < 0)
+			value /= powersOfTen[-exponent];
+		else
+			value *= powersOfTen[exponent];
+
+		number = negative ? -value : value;
+		return false;
+	}
+
+	//Hard cases (Long mantissas, big exponents), std::from_chars is exact and on current standard libraries runs Eisel-Lemire itself
+	number = 0.0;
+	if (std::from_chars(token.data(), token.data() + token.size(), number).ec == std::errc::result_out_of_range) { //Left untouched, saturate instead
+		//Decimal magnitude: significant digits plus the exponent, so 1e400 and 1000...0e-10 overflow while 0.000...1 underflows
+		size_t leadingZeros = 0;
+		for (const char* digit = integerStart; digit != end && (*digit == '0' || *digit == '.'); ++digit) {
+			if (*digit == '0')
+				++leadingZeros;
+		}
+
+		number = (int64_t)(digitCount - leadingZeros) + exponent > 0 ? HUGE_VAL : 0.0;
+		if (negative)
+			number = -number;
+	}
+
+	return false;
+}
+
+void JSON::ParseDigits(const char*& character, const char* end, uint64_t& mantissa) {
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_WIN32)
+	//SWAR: 8 digits per step
+	while (end - character >= 8) {
+		uint64_t chunk;
+		memcpy(&chunk, character, sizeof(uint64_t));
+
+		//All 8 bytes are within '0'..'9'
+		if (((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) != 0x3333333333333333)
+			break;
+
+		chunk = (chunk & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+		chunk = (chunk & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+		chunk = (chunk & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+
+		mantissa = mantissa * 100000000 + (uint32_t)chunk;
+		character += 8;
+	}
+#endif
+
+	for (; character != end && (uint8_t)(*character - '0') < 10; ++character)
+		mantissa = mantissa * 10 + (*character - '0');
 }
 
 
@@ -367,7 +1023,7 @@ void JSON::GetToken(const std::string_view& source, size_t& i, std::string_view&
 		}
 
 
-		const std::vector<uint8_t>& delimiters = { ',', ':', '{', '}', '[', ']', ' ', '\r', '\n', '\t', '\v', '\f' }; //Whitespace included
+		static constexpr std::string_view delimiters = ",:{}[] \r\n\t\v\f"; //Whitespace included, trivially destructible so tokenizing stays safe during static destruction
 		SubstringOnCharacter(std::string_view(&source[i], source.size() - i), token, delimiters);
 		i += token.size();
 		return;
@@ -376,7 +1032,7 @@ void JSON::GetToken(const std::string_view& source, size_t& i, std::string_view&
 }
 
 
-bool JSON::SubstringOnCharacter(const std::string_view& string, std::string_view& substring, const std::vector<uint8_t>& characters) {
+bool JSON::SubstringOnCharacter(const std::string_view& string, std::string_view& substring, const std::string_view& characters) {
 
 	for (size_t i = 0; i < string.size(); ++i) {
 		const uint8_t character = string[i];
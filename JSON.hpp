@@ -2,22 +2,402 @@
 
 #include "Variant.hpp"
 
+#include <array>
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+
 class JSON {
 
+	class StreamReader; //Windowed reading shared by ArrayReader and ObjectReader, defined in JSONReader.cpp
+
 public:
 
+	//Dictionary key name meant to be constructed from literals (Example: static constexpr JSON::Key translation = "translation";), its length is known upfront and lookups go through a reused buffer instead of a temporary std::string. It carries no precomputed hash, C++17 std::unordered_map can't take one so the map still hashes the name on every lookup
+	class Key {
+
+	public:
+
+		template <size_t N>
+		constexpr Key(const char (&literal)[N]) : name(literal, N - 1) {}
+
+		constexpr Key(const std::string_view& string) : name(string) {}
+
+
+		constexpr const std::string_view& GetName() const {
+			return name;
+		}
+
+		constexpr bool operator==(const Key& other) const {
+			return name == other.name;
+		}
+
+	private:
+
+		std::string_view name;
+	};
+
+
+	//Immutable document stored as a single contiguous tape of tagged 64 bit words plus a string buffer, containers know where they end so subtrees are skipped in O(1)
+	class Tape {
+
+	public:
+
+		class Value {
+
+		public:
+
+			class Iterator {
+
+			public:
+
+				Value operator*() const {
+					return Value(tape, isObject ? index + 1 : index);
+				}
+
+				Iterator& operator++() {
+					index = tape->Skip(isObject ? index + 1 : index);
+					return *this;
+				}
+
+				bool operator!=(const Iterator& other) const {
+					return index != other.index;
+				}
+
+				std::string_view GetKey() const { //Only for object members
+					return tape->GetString(index);
+				}
+
+			private:
+
+				friend class Value;
+
+				Iterator(const Tape* pTape, size_t pIndex, bool pIsObject) : tape(pTape), index(pIndex), isObject(pIsObject) {}
+
+				const Tape* tape;
+				size_t index;
+				bool isObject;
+			};
+
+
+			Value() : tape(nullptr), index(0) {}
+
+			Variant::Type GetType() const; //Null is reported as Pointer, same as ParseJSON
+
+			inline bool IsValid() const {
+				return tape != nullptr;
+			}
+
+			bool IsNull() const;
+			bool GetBool() const;
+			int64_t GetInt() const;
+			double GetFloat() const;
+			std::string_view GetString() const;
+
+			size_t Size() const; //Elements of arrays or members of objects
+			Value operator[](size_t index) const; //Array element, invalid if out of range
+			Value Find(const Key& key) const; //Object member, invalid if missing
+
+			Iterator begin() const;
+			Iterator end() const;
+
+			Variant ToVariant() const;
+
+		private:
+
+			friend class Tape;
+
+			Value(const Tape* pTape, size_t pIndex) : tape(pTape), index(pIndex) {}
+
+			const Tape* tape;
+			size_t index;
+		};
+
+
+		Value GetRoot() const {
+			if (words.empty())
+				return Value();
+
+			return Value(this, 0);
+		}
+
+		inline size_t GetWordCount() const {
+			return words.size();
+		}
+
+	private:
+
+		friend class JSON;
+
+		enum Tag : uint8_t {
+			ObjectStart = '{', //Payload: Index past the end word
+			ObjectEnd = '}', //Payload: Element count
+			ArrayStart = '[',
+			ArrayEnd = ']',
+			StringTag = '"', //Payload: Offset of the string in the string buffer, prefixed by its uint64_t length
+			IntTag = 'l', //Followed by the raw int64_t word
+			FloatTag = 'd', //Followed by the raw double word
+			TrueTag = 't',
+			FalseTag = 'f',
+			NullTag = 'n'
+		};
+
+		static constexpr uint64_t PayloadMask = (1ull << 56) - 1;
+
+		inline Tag GetTag(size_t index) const {
+			return (Tag)(words[index] >> 56);
+		}
+
+		inline uint64_t GetPayload(size_t index) const {
+			return words[index] & PayloadMask;
+		}
+
+		size_t Skip(size_t index) const; //Index of the next sibling
+		std::string_view GetString(size_t index) const;
+
+		std::vector<uint64_t> words;
+		std::string strings;
+	};
+
+
+	class SharedDocument; //In JSONShared.hpp, so <atomic>, <future> and <mutex> are only included where it's used
+	class FileLoader; //In JSONAsync.hpp, same reason
+
+
+	//Set of JSON Pointer paths to keep when parsing, array indices pick single elements and "*" matches every array element or object member (Example: "/nodes/*/translation")
+	//Containers left without any projected value are omitted and kept array elements are packed in order, so projecting "/nodes/2" gives a one element "nodes" array
+	class Projection {
+
+	public:
+
+		Projection(const std::vector<std::string>& paths);
+
+	private:
+
+		friend class JSON;
+
+		struct Node {
+			std::string key;
+			bool leaf = false; //Whole subtree is kept
+			std::vector<Node> children; //Sorted by key
+			size_t wildcard = SIZE_MAX; //Index of the "*" child
+			bool indexed = false; //Some children are array indices
+
+			const Node* Find(const std::string_view& name) const; //Exact match first, then wildcard
+			const Node* Find(size_t element) const; //Array element, same matching as its index written in decimal
+			void Sort();
+		};
+
+		Node root;
+	};
+
+
+	//Chunked input for ArrayReader and ObjectReader
+	class Source {
+
+	public:
+
+		virtual ~Source() = default;
+
+		virtual size_t Read(char* data, size_t size) = 0; //Returns how many bytes were written, 0 at the end of the input
+	};
+
+
+	//Reads the elements of a top level array one at a time from a buffer or a chunked source, memory stays bounded by the biggest element instead of the whole input
+	class ArrayReader {
+
+	public:
+
+		ArrayReader(const std::string_view& buffer); //Must outlive the reader
+		ArrayReader(std::unique_ptr<Source> source);
+		~ArrayReader();
+
+		ArrayReader(ArrayReader&& other) noexcept;
+		ArrayReader& operator=(ArrayReader&& other) noexcept;
+
+		static ArrayReader FromFile(const std::string& path);
+
+		bool Next(Variant& element); //Replaces element with the next one, false once the array ended or the input isn't an array
+
+	private:
+
+		std::unique_ptr<StreamReader> reader;
+	};
+
+
+	//Same as ArrayReader for the members of a top level object
+	class ObjectReader {
+
+	public:
+
+		ObjectReader(const std::string_view& buffer);
+		ObjectReader(std::unique_ptr<Source> source);
+		~ObjectReader();
+
+		ObjectReader(ObjectReader&& other) noexcept;
+		ObjectReader& operator=(ObjectReader&& other) noexcept;
+
+		static ObjectReader FromFile(const std::string& path);
+
+		bool Next(std::string& key, Variant& value); //False once the object ended or the input isn't an object
+
+	private:
+
+		std::unique_ptr<StreamReader> reader;
+	};
+
+
+	//Random access into a file through the sidecar written by BuildIndex, only the requested subtree is read and parsed
+	class IndexedFile {
+
+	public:
+
+		IndexedFile(const std::string& path); //Opens path + ".idx", invalid if missing or stale
+		~IndexedFile();
+
+		IndexedFile(IndexedFile&& other) noexcept;
+		IndexedFile& operator=(IndexedFile&& other) noexcept;
+
+		inline bool IsValid() const {
+			return valid;
+		}
+
+		bool Get(const std::string& pointer, Variant& value); //JSON Pointer, each token costs a binary search through the sidecar and at most a few KiB read from the file, missing keys and out of range indices down to maxDepth fail without reading the value
+
+	private:
+
+		std::string path;
+		std::unique_ptr<std::ifstream> file; //Behind pointers so <fstream> stays out of this header
+		std::unique_ptr<std::ifstream> index; //Searched in place, never loaded
+		uint64_t indexSize = 0;
+		uint64_t fileSize = 0;
+		uint64_t rootTable = 0; //Offset in the sidecar
+		bool valid = false;
+	};
+
+
+	//Compiled subset of JSON Schema (type, enum, minimum, maximum, exclusiveMinimum, exclusiveMaximum, properties, required, items) checked while parsing, exclusive bounds are accepted as draft 4 booleans or later draft numbers
+	class Schema {
+
+	public:
+
+		Schema(const std::unordered_map<std::string, Variant>& schema);
+
+	private:
+
+		friend class JSON;
+
+		enum TypeFlags : uint8_t {
+			NullType = 1 << 0,
+			BoolType = 1 << 1,
+			IntegerType = 1 << 2,
+			NumberType = 1 << 3,
+			StringType = 1 << 4,
+			ArrayType = 1 << 5,
+			ObjectType = 1 << 6,
+			AnyType = 0x7F
+		};
+
+		struct Node {
+			std::string key; //Property name
+			uint8_t types = AnyType;
+			bool hasMinimum = false;
+			bool hasMaximum = false;
+			bool exclusiveMinimum = false;
+			bool exclusiveMaximum = false;
+			double minimum = 0.0;
+			double maximum = 0.0;
+			std::vector<Variant> enumValues;
+			std::vector<Node> properties;
+			std::vector<std::string> required;
+			std::vector<Node> items; //Empty or a single node
+
+			const Node* FindProperty(const std::string_view& name) const;
+		};
+
+		static void Compile(const Variant& schema, Node& node);
+
+		Node root;
+	};
+
+
 	static std::string ToJSON(const std::unordered_map<std::string, Variant>& map, bool prettyPrint = false);
 	static std::unordered_map<std::string, Variant> ParseJSON(const std::string& string);
+	static std::unordered_map<std::string, Variant> ParseJSON(const std::string& string, const Projection& projection); //Only the projected fields are materialized, the rest is skipped without conversion
+	static bool ParseJSON(const std::string& string, const Schema& schema, std::unordered_map<std::string, Variant>& map, size_t& errorOffset); //Validates and coerces while parsing (Example: "number" stores integers as Float, arrays of primitive items become packed arrays), stops on the first violation
+	static void ParseInto(std::unordered_map<std::string, Variant>& map, const std::string& string); //Parses over an existing map reusing its allocations where the shape matches
+
+	//Non allocating dictionary lookups, returns nullptr if the key is missing or the variant isn't a dictionary
+	static Variant* Find(std::unordered_map<std::string, Variant>& map, const Key& key);
+	static const Variant* Find(const std::unordered_map<std::string, Variant>& map, const Key& key);
+	static const Variant* Find(const Variant& dictionary, const Key& key);
+
+	//Resolves several keys at once (Example: auto [translation, rotation] = JSON::Get(map, "translation", "rotation");)
+	template <typename... Keys>
+	static std::array<const Variant*, sizeof...(Keys)> Get(const std::unordered_map<std::string, Variant>& map, const Keys&... keys);
+
+	//RFC 6902 JSON Patch, operations are dictionaries with "op", "path" and "value"/"from" entries
+	static std::vector<Variant> Diff(const std::unordered_map<std::string, Variant>& from, const std::unordered_map<std::string, Variant>& to);
+	static bool ApplyPatch(std::unordered_map<std::string, Variant>& map, const std::vector<Variant>& patch); //Applied in place, returns false on the first failing operation leaving the previous ones applied
+
+	//Strict RFC 8259 and UTF-8 well-formedness check that allocates nothing, errorOffset receives the byte offset of the first error
+	static bool Validate(const std::string_view& string);
+	static bool Validate(const std::string_view& string, size_t& errorOffset);
+
+	//Decompresses (gzip with JSON_GZIP_EXTENSION, zstd with JSON_ZSTD_EXTENSION, or plain text) on another thread while parsing, only the biggest top level member is held as text at once
+	//Returns false if the file can't be read, is empty, uses a compression that isn't compiled in, or its compressed data is corrupt or truncated (Malformed text ends the map at the last complete member, as with ParseJSON)
+	static bool ParseCompressedFile(const std::string& path, std::unordered_map<std::string, Variant>& map);
+
+	//Writes path + ".idx", a tree of tables for the containers down to maxDepth (Root is depth 0) bigger than 4KiB, with sparse checkpoints into arrays and a key hash directory for objects, validated against the file size, modification time and a sampled hash
+	static bool BuildIndex(const std::string& path, uint32_t maxDepth = 2);
+
+	//Read only alternative to ParseJSON, parses the first value found (Not only objects)
+	static Tape ParseTape(const std::string_view& string);
 
 private:
 
 	template <bool PrettyPrint>
 	static void WriteValue(const Variant& variant, std::string& string, uint32_t indentation = 1);
 
-	static void ParseValue(Variant& toContainer, const std::string& string, size_t& index);
+	static bool ParseValue(Variant& toContainer, const std::string_view& string, size_t& index, const Projection::Node* projection = nullptr, const Schema::Node* schema = nullptr); //Returns false on a schema violation
+	static bool CheckSchema(Variant& variant, const Schema::Node& schema); //Coerces numbers to the schema type
+	static Variant MakeArray(const Schema::Node& schema); //Packed array if the items are a single primitive type
+	static void PutPacked(Variant& container, Variant& variant);
+	static void SkipValue(const std::string_view& string, size_t& index); //Bracket balanced skip of the next value, without unescaping or converting
+	static void ParseValueInto(Variant& toContainer, const std::string_view& string, size_t& index);
+
+	static void UnescapeString(const std::string_view& token, std::string& string);
+	static bool ParseNumber(const std::string_view& token, int64_t& integer, double& number); //Returns true if it's an integer
+	static void ParseDigits(const char*& character, const char* end, uint64_t& mantissa);
 
 	static void GetToken(const std::string_view& source, size_t& i, std::string_view& token);
-	static bool SubstringOnCharacter(const std::string_view& string, std::string_view& substring, const std::vector<uint8_t>& characters);
+	static bool SubstringOnCharacter(const std::string_view& string, std::string_view& substring, const std::string_view& characters);
+
+	static bool Equals(const Variant& a, const Variant& b);
+	static void DiffValue(const Variant& from, const Variant& to, std::string& path, std::vector<Variant>& patch);
+	static void PushOperation(std::vector<Variant>& patch, const char* op, const std::string& path, const Variant* value);
+	static void AppendPointerToken(std::string& path, const std::string_view& token);
+	static void UnescapePointerToken(const std::string_view& token, std::string& string);
+	static Variant* ResolvePointer(Variant& root, const std::string_view& pointer);
+	static Variant* ResolveParent(Variant& root, const std::string_view& pointer, std::string& lastToken);
+	static Variant* GetChild(Variant& container, const std::string& token);
+	static bool ParseArrayIndex(const std::string_view& token, size_t& index);
+	static bool AddValue(Variant& root, const std::string_view& pointer, Variant&& value);
+	static bool RemoveValue(Variant& root, const std::string_view& pointer, Variant* removed);
+
+	static void GetKeys(const std::unordered_map<std::string, Variant>& map, const Key* keys, const Variant** results, size_t count);
 
 	JSON() = delete;
 };
+
+
+template <typename... Keys>
+std::array<const Variant*, sizeof...(Keys)> JSON::Get(const std::unordered_map<std::string, Variant>& map, const Keys&... keys) {
+
+	const Key keyArray[] = { Key(keys)... };
+
+	std::array<const Variant*, sizeof...(Keys)> results;
+	GetKeys(map, keyArray, results.data(), sizeof...(Keys));
+
+	return results;
+}
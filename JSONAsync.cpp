@@ -0,0 +1,231 @@
+#include "JSONAsync.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+
+//State shared by the I/O and parse threads of one FileLoader::LoadAsync call, each thread holds a reference so the batch lives until the last one exits
+class BatchLoader {
+
+public:
+
+	BatchLoader(const std::vector<std::string>& pPaths, std::function<void(JSON::FileLoader::Result&)> pCallback, size_t pMemoryBudget, size_t pMaxQueued, uint32_t ioThreads, uint32_t parseThreads) : paths(pPaths), callback(std::move(pCallback)), memoryBudget(pMemoryBudget), maxQueued(pMaxQueued), activeReaders(ioThreads), activeThreads(ioThreads + parseThreads) {}
+
+	std::future<void> GetFuture() {
+		return done.get_future();
+	}
+
+	void ReadFiles() {
+
+		while (true) {
+			const size_t index = nextPath++;
+			if (index >= paths.size())
+				break;
+
+			Pending pending;
+			pending.index = index;
+
+			try {
+				Read(pending);
+			}
+			catch (const std::exception& exception) { //Allocation failures for huge files
+				pending.contents = std::string();
+				pending.error = std::string("Couldn't read file: ") + exception.what();
+			}
+
+			Push(std::move(pending));
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			--activeReaders;
+			queueCondition.notify_all();
+		}
+
+		Exit();
+	}
+
+	void ParseFiles() {
+
+		while (true) {
+			Pending pending;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				queueCondition.wait(lock, [this]() { return !queue.empty() || activeReaders == 0; });
+				if (queue.empty())
+					break;
+
+				pending = std::move(queue.front());
+				queue.pop_front();
+			}
+
+			JSON::FileLoader::Result result;
+			result.path = paths[pending.index];
+			result.error = std::move(pending.error);
+			if (result.error.empty()) {
+				try {
+					result.map = JSON::ParseJSON(pending.contents);
+				}
+				catch (const std::exception& exception) {
+					result.map.clear();
+					result.error = std::string("Couldn't parse file: ") + exception.what();
+				}
+			}
+
+			pending.contents = std::string(); //Release before the budget is given back
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				bytesHeld -= pending.budget;
+				budgetCondition.notify_all();
+			}
+
+			try {
+				callback(result);
+			}
+			catch (...) { //The remaining files are still delivered, the first exception is rethrown by the future
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!callbackException)
+					callbackException = std::current_exception();
+			}
+		}
+
+		Exit();
+	}
+
+private:
+
+	struct Pending {
+		size_t index = 0;
+		size_t budget = 0; //Bytes taken from memoryBudget
+		std::string contents;
+		std::string error;
+	};
+
+	void Read(Pending& pending) {
+
+		std::ifstream file(paths[pending.index], std::ios::binary | std::ios::ate);
+		if (!file) {
+			pending.error = "Couldn't open file";
+			return;
+		}
+
+		//Directories open fine on some platforms and report a bogus size
+		std::error_code error;
+		const std::streamoff end = file.tellg();
+		if (end < 0 || !std::filesystem::is_regular_file(paths[pending.index], error)) {
+			pending.error = "Couldn't read file";
+			return;
+		}
+
+		const size_t size = (size_t)end;
+
+		//Wait for budget, a file bigger than the whole budget is still let through alone. Reading only a few files ahead of the parsers keeps them working on cache warm contents
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			budgetCondition.wait(lock, [&]() { return bytesHeld == 0 || (bytesHeld + size <= memoryBudget && queue.size() < maxQueued); });
+			bytesHeld += size;
+			pending.budget = size;
+		}
+
+		pending.contents.resize(size);
+		file.seekg(0);
+		file.read(&pending.contents[0], size);
+		if (!file) {
+			pending.contents = std::string();
+			pending.error = "Couldn't read file";
+		}
+	}
+
+	void Push(Pending&& pending) {
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.push_back(std::move(pending));
+		queueCondition.notify_one();
+	}
+
+	void Exit() { //The last thread out completes the batch
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--activeThreads > 0)
+			return;
+
+		if (callbackException)
+			done.set_exception(callbackException);
+		else
+			done.set_value();
+	}
+
+	std::vector<std::string> paths;
+	std::function<void(JSON::FileLoader::Result&)> callback;
+	size_t memoryBudget;
+	size_t maxQueued; //Files read but not picked up by a parse thread yet
+
+	std::atomic<size_t> nextPath = 0;
+	size_t bytesHeld = 0; //Read but not parsed yet
+	std::deque<Pending> queue;
+	uint32_t activeReaders;
+	uint32_t activeThreads;
+	std::exception_ptr callbackException;
+	std::promise<void> done;
+
+	std::mutex mutex;
+	std::condition_variable queueCondition;
+	std::condition_variable budgetCondition;
+};
+
+
+std::vector<std::future<JSON::FileLoader::Result>> JSON::FileLoader::LoadAsync(const std::vector<std::string>& paths, size_t memoryBudget, uint32_t ioThreads, uint32_t parseThreads) {
+
+	//Results are matched back to their paths, so each file gets its own future in input order
+	auto promises = std::make_shared<std::vector<std::promise<Result>>>(paths.size());
+
+	std::vector<std::future<Result>> futures;
+	futures.reserve(paths.size());
+	for (auto& promise : *promises)
+		futures.push_back(promise.get_future());
+
+	auto indices = std::make_shared<std::unordered_map<std::string, std::vector<size_t>>>(); //Paths can repeat
+	for (size_t i = paths.size(); i-- > 0;)
+		(*indices)[paths[i]].push_back(i);
+
+	auto mutex = std::make_shared<std::mutex>();
+
+	//Its future is dropped without blocking, the promises are kept alive by the batch's threads
+	LoadAsync(paths, [promises, indices, mutex](Result& result) {
+		size_t index;
+		{
+			std::lock_guard<std::mutex> lock(*mutex);
+			std::vector<size_t>& pathIndices = (*indices)[result.path];
+			index = pathIndices.back();
+			pathIndices.pop_back();
+		}
+
+		(*promises)[index].set_value(std::move(result));
+	}, memoryBudget, ioThreads, parseThreads);
+
+	return futures;
+}
+
+std::future<void> JSON::FileLoader::LoadAsync(const std::vector<std::string>& paths, std::function<void(Result& result)> callback, size_t memoryBudget, uint32_t ioThreads, uint32_t parseThreads) {
+
+	ioThreads = std::max(ioThreads, 1u);
+	if (parseThreads == 0)
+		parseThreads = std::max(std::thread::hardware_concurrency(), ioThreads + 1) - ioThreads;
+
+	auto loader = std::make_shared<BatchLoader>(paths, std::move(callback), memoryBudget, 2 * (size_t)parseThreads, ioThreads, parseThreads);
+	std::future<void> future = loader->GetFuture();
+
+	//Detached, the returned future completes when the last thread exits and dropping it doesn't wait
+	for (uint32_t i = 0; i < ioThreads; ++i)
+		std::thread([loader]() { loader->ReadFiles(); }).detach();
+
+	for (uint32_t i = 0; i < parseThreads; ++i)
+		std::thread([loader]() { loader->ParseFiles(); }).detach();
+
+	return future;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "JSON.hpp"
+
+#include <functional>
+#include <future>
+
+
+//Batch loading of many files, reading them on I/O threads while parsing the ones already read on a pool
+class JSON::FileLoader {
+
+public:
+
+	struct Result {
+		std::string path;
+		std::unordered_map<std::string, Variant> map;
+		std::string error; //Empty on success
+	};
+
+
+	//Reads files on ioThreads while parsing them on parseThreads (0: hardware threads left), holding at most memoryBudget bytes of unparsed text at once
+	//The threads are detached and own the batch, dropping the returned futures doesn't wait for them. Files that can't be read or parsed get an error instead of a map
+	static std::vector<std::future<Result>> LoadAsync(const std::vector<std::string>& paths, size_t memoryBudget = 64 * 1024 * 1024, uint32_t ioThreads = 2, uint32_t parseThreads = 0);
+	static std::future<void> LoadAsync(const std::vector<std::string>& paths, std::function<void(Result& result)> callback, size_t memoryBudget = 64 * 1024 * 1024, uint32_t ioThreads = 2, uint32_t parseThreads = 0); //Callback runs on the parse threads, the future completes after the last one and rethrows the first exception a callback threw
+
+	FileLoader() = delete;
+};
@@ -0,0 +1,332 @@
+#include "JSON.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#ifdef JSON_GZIP_EXTENSION
+#include <zlib.h> //Link with zlib
+#endif
+
+#ifdef JSON_ZSTD_EXTENSION
+#include <zstd.h> //Link with libzstd
+#endif
+
+
+//Bounded single producer single consumer queue of fixed size chunks between the decompression and the parsing threads
+class CompressedChunkRing {
+
+public:
+
+	static constexpr size_t ChunkCount = 8;
+	static constexpr size_t ChunkSize = 256 * 1024;
+
+	CompressedChunkRing() {
+		for (std::string& chunk : chunks)
+			chunk.resize(ChunkSize);
+	}
+
+	char* AcquireWrite() { //nullptr if the consumer is gone
+
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [this]() { return count < ChunkCount || cancelled; });
+		if (cancelled)
+			return nullptr;
+
+		return &chunks[(head + count) % ChunkCount][0];
+	}
+
+	void CommitWrite(size_t size) {
+
+		std::lock_guard<std::mutex> lock(mutex);
+		sizes[(head + count) % ChunkCount] = size;
+		++count;
+		condition.notify_all();
+	}
+
+	void Close() { //Producer finished
+		std::lock_guard<std::mutex> lock(mutex);
+		closed = true;
+		condition.notify_all();
+	}
+
+	void Cancel() { //Consumer finished
+		std::lock_guard<std::mutex> lock(mutex);
+		cancelled = true;
+		condition.notify_all();
+	}
+
+	size_t Read(char* data, size_t size) { //0 once closed and drained
+
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [this]() { return count > 0 || closed; });
+		if (count == 0)
+			return 0;
+
+		const size_t available = sizes[head] - readOffset;
+		const size_t copied = std::min(size, available);
+		memcpy(data, &chunks[head][readOffset], copied);
+
+		readOffset += copied;
+		if (readOffset == sizes[head]) { //Chunk drained, give it back to the producer
+			head = (head + 1) % ChunkCount;
+			--count;
+			readOffset = 0;
+			condition.notify_all();
+		}
+
+		return copied;
+	}
+
+private:
+
+	std::string chunks[ChunkCount];
+	size_t sizes[ChunkCount] = {};
+	size_t head = 0; //Oldest filled chunk
+	size_t count = 0; //Filled chunks
+	size_t readOffset = 0;
+	bool closed = false;
+	bool cancelled = false;
+
+	std::mutex mutex;
+	std::condition_variable condition;
+};
+
+
+//Parser side of the ring
+class CompressedChunkSource : public JSON::Source {
+
+public:
+
+	CompressedChunkSource(CompressedChunkRing& pRing) : ring(pRing) {}
+
+	size_t Read(char* data, size_t size) override {
+		return ring.Read(data, size);
+	}
+
+private:
+
+	CompressedChunkRing& ring;
+};
+
+
+//Decompressors return false on corrupt or truncated data, stopping early because the parser cancelled the ring isn't an error
+static bool DecompressPlain(std::ifstream& file, CompressedChunkRing& ring) {
+
+	while (char* chunk = ring.AcquireWrite()) {
+		file.read(chunk, CompressedChunkRing::ChunkSize);
+		const size_t size = (size_t)file.gcount();
+		if (size == 0)
+			return !file.bad();
+
+		ring.CommitWrite(size);
+	}
+
+	return true;
+}
+
+#ifdef JSON_GZIP_EXTENSION
+static bool DecompressGzip(std::ifstream& file, CompressedChunkRing& ring) {
+
+	z_stream stream = {};
+	if (inflateInit2(&stream, 15 + 32) != Z_OK) //+32: Detect gzip or zlib headers
+		return false;
+
+	std::string input(64 * 1024, '\0');
+	char* chunk = ring.AcquireWrite();
+	size_t chunkSize = 0;
+	bool ended = false; //No input left
+	bool complete = false; //Last member ended
+	bool corrupt = false;
+
+	while (chunk != nullptr) {
+		if (stream.avail_in == 0 && !ended) {
+			file.read(&input[0], input.size());
+			stream.next_in = (Bytef*)&input[0];
+			stream.avail_in = (uInt)file.gcount();
+			ended = stream.avail_in == 0;
+		}
+
+		stream.next_out = (Bytef*)chunk + chunkSize;
+		stream.avail_out = (uInt)(CompressedChunkRing::ChunkSize - chunkSize);
+
+		const int result = inflate(&stream, Z_NO_FLUSH);
+		const size_t previousSize = chunkSize;
+		chunkSize = CompressedChunkRing::ChunkSize - stream.avail_out;
+
+		if (result == Z_STREAM_END) { //Concatenated gzip members are valid, keep going if there's more input
+			complete = true;
+			if (inflateReset(&stream) != Z_OK) {
+				corrupt = true;
+				break;
+			}
+		}
+		else if (result == Z_OK) { //Progress inside a member
+			complete = false;
+		}
+		else if (result != Z_BUF_ERROR) {
+			corrupt = true;
+			break;
+		}
+
+		if (chunkSize == CompressedChunkRing::ChunkSize) { //Full, inflate may still hold output so it's called again even without input
+			ring.CommitWrite(chunkSize);
+			chunk = ring.AcquireWrite();
+			chunkSize = 0;
+		}
+		else if (ended && chunkSize == previousSize) { //Flushed everything
+			break;
+		}
+	}
+
+	if (chunk != nullptr && chunkSize > 0)
+		ring.CommitWrite(chunkSize);
+
+	inflateEnd(&stream);
+
+	return !corrupt && (chunk == nullptr || complete);
+}
+#endif
+
+#ifdef JSON_ZSTD_EXTENSION
+static bool DecompressZstd(std::ifstream& file, CompressedChunkRing& ring) {
+
+	ZSTD_DStream* stream = ZSTD_createDStream();
+	if (stream == nullptr)
+		return false;
+
+	std::string input(ZSTD_DStreamInSize(), '\0');
+	ZSTD_inBuffer in = { input.data(), 0, 0 };
+
+	char* chunk = ring.AcquireWrite();
+	ZSTD_outBuffer out = { chunk, CompressedChunkRing::ChunkSize, 0 };
+	bool ended = false;
+	size_t remaining = 0; //0 once a frame is completely decoded and flushed
+
+	while (chunk != nullptr) {
+		if (in.pos == in.size && !ended) {
+			file.read(&input[0], input.size());
+			in.size = (size_t)file.gcount();
+			in.pos = 0;
+			ended = in.size == 0;
+		}
+
+		const size_t previousPos = out.pos;
+		const size_t previousIn = in.pos;
+		const size_t result = ZSTD_decompressStream(stream, &out, &in);
+		if (ZSTD_isError(result)) {
+			remaining = result;
+			break;
+		}
+
+		if (out.pos != previousPos || in.pos != previousIn) //Without progress it only hints at the next frame's header size
+			remaining = result;
+
+		if (out.pos == out.size) { //Full, the DStream may still buffer decoded data so it's called again even without input
+			ring.CommitWrite(out.pos);
+			chunk = ring.AcquireWrite();
+			out = { chunk, CompressedChunkRing::ChunkSize, 0 };
+		}
+		else if (ended && out.pos == previousPos) { //Flushed everything
+			break;
+		}
+	}
+
+	if (chunk != nullptr && out.pos > 0)
+		ring.CommitWrite(out.pos);
+
+	ZSTD_freeDStream(stream);
+
+	return chunk == nullptr || remaining == 0;
+}
+#endif
+
+
+//Runs the decompressor and joins it on every exit of ParseCompressedFile, including exceptions thrown while parsing
+class DecompressorThread {
+
+public:
+
+	DecompressorThread(bool (*decompress)(std::ifstream&, CompressedChunkRing&), std::ifstream& file, CompressedChunkRing& pRing) : ring(pRing) {
+		thread = std::thread([this, decompress, &file]() {
+			try {
+				succeeded = decompress(file, ring);
+			}
+			catch (...) { //Allocation failures, reported as a failed decompression
+			}
+
+			ring.Close();
+		});
+	}
+
+	~DecompressorThread() {
+		Join();
+	}
+
+	bool Join() { //Stops the decompressor early if parsing ended first, returns false if the data was corrupt
+
+		ring.Cancel();
+		if (thread.joinable())
+			thread.join();
+
+		return succeeded;
+	}
+
+private:
+
+	CompressedChunkRing& ring;
+	bool succeeded = false;
+	std::thread thread;
+};
+
+
+bool JSON::ParseCompressedFile(const std::string& path, std::unordered_map<std::string, Variant>& map) {
+
+	map.clear();
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	//Detect the format by its magic bytes
+	uint8_t magic[4] = {};
+	file.read((char*)magic, sizeof(magic));
+	const size_t magicSize = (size_t)file.gcount();
+	if (magicSize == 0) //Empty, or not a regular file (Example: A directory)
+		return false;
+
+	file.clear();
+	file.seekg(0);
+
+	bool (*decompress)(std::ifstream&, CompressedChunkRing&) = DecompressPlain;
+
+	if (magicSize >= 2 && magic[0] == 0x1F && magic[1] == 0x8B) {
+#ifdef JSON_GZIP_EXTENSION
+		decompress = DecompressGzip;
+#else
+		return false; //Gzip support not compiled in
+#endif
+	}
+	else if (magicSize >= 4 && magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD) {
+#ifdef JSON_ZSTD_EXTENSION
+		decompress = DecompressZstd;
+#else
+		return false; //Zstd support not compiled in
+#endif
+	}
+
+	//Decompress on another thread while the members of the top level object are parsed as they arrive, so the whole text is never held at once
+	CompressedChunkRing ring;
+	DecompressorThread decompressor(decompress, file, ring);
+
+	ObjectReader reader(std::make_unique<CompressedChunkSource>(ring));
+
+	std::string key;
+	Variant value;
+	while (reader.Next(key, value))
+		map[key] = std::move(value);
+
+	return decompressor.Join();
+}
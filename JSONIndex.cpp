@@ -0,0 +1,612 @@
+#include "JSON.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+//Sidecar layout: header, then one table per value that's referenced from a parent table, written as values end (Children before their parents)
+//A table holds the byte range of its value, plus for containers shallower than maxDepth and not smaller than indexGranularity:
+//- Checkpoints sorted by ordinal: the first element or member, every one with a table of its own, and one at least every indexGranularity bytes, so any other one is found by scanning less than twice that
+//- For objects, the key hash and checkpoint of every member sorted by hash, so missing keys fail without reading the file
+static constexpr char indexMagic[4] = { 'N', 'J', 'I', 'X' };
+static constexpr uint32_t indexVersion = 2;
+static constexpr size_t indexSampleSize = 64 * 1024;
+static constexpr uint64_t indexGranularity = 4 * 1024; //Values smaller than this are read whole instead of through a table
+
+
+struct IndexHeader {
+	char magic[4]; //Zeroed until the build completes
+	uint32_t version;
+	uint32_t maxDepth;
+	uint32_t padding;
+	uint64_t fileSize;
+	int64_t modificationTime;
+	uint64_t hash; //Of the first and last 64KiB, hashing the whole file would cost as much as the scan the index avoids
+	uint64_t rootTable;
+};
+
+struct IndexTable {
+
+	enum Flags : uint32_t {
+		Object = 1 << 0,
+		Checkpoints = 1 << 1 //Without them the value is read whole
+	};
+
+	uint32_t flags;
+	uint32_t padding;
+	uint64_t offset; //Byte range of the value
+	uint64_t length;
+	uint64_t count; //Elements or members
+	uint64_t checkpointCount;
+};
+
+struct IndexCheckpoint {
+	uint64_t ordinal; //Element or member number
+	uint64_t offset; //Of the value for arrays, of the key for objects
+	uint64_t table; //0 if the value is smaller than indexGranularity
+};
+
+struct IndexKey {
+	uint32_t hash;
+	uint32_t checkpoint; //Whose window holds the member
+};
+
+
+static uint64_t HashBytes(const std::string_view& bytes) { //FNV-1a
+	uint64_t result = 14695981039346656037ull;
+	for (const char c : bytes) {
+		result ^= (uint8_t)c;
+		result *= 1099511628211ull;
+	}
+
+	return result;
+}
+
+static bool GetFileStamp(const std::string& path, std::ifstream& file, uint64_t& size, int64_t& modificationTime, uint64_t& hash) {
+
+	std::error_code error;
+	size = (uint64_t)std::filesystem::file_size(path, error);
+	if (error)
+		return false;
+
+	modificationTime = (int64_t)std::filesystem::last_write_time(path, error).time_since_epoch().count();
+	if (error)
+		return false;
+
+	std::string sample(std::min<uint64_t>(size, indexSampleSize), '\0');
+	file.clear();
+	file.seekg(0);
+	file.read(&sample[0], sample.size());
+
+	if (size > indexSampleSize) {
+		const size_t headSize = sample.size();
+		sample.resize(headSize + indexSampleSize);
+		file.seekg(size - indexSampleSize);
+		file.read(&sample[headSize], indexSampleSize);
+	}
+
+	hash = HashBytes(sample);
+	return (bool)file;
+}
+
+static bool ReadAt(std::ifstream& stream, uint64_t offset, void* data, size_t size) {
+	stream.clear();
+	stream.seekg((std::streamoff)offset);
+	stream.read((char*)data, size);
+	return (bool)stream;
+}
+
+static bool ReadTable(std::ifstream& index, uint64_t indexSize, uint64_t fileSize, uint64_t position, IndexTable& table) { //Bounds checked against both files
+
+	if (position < sizeof(IndexHeader) || position > indexSize || indexSize - position < sizeof(IndexTable) || !ReadAt(index, position, &table, sizeof(table)))
+		return false;
+
+	if (table.length > fileSize || table.offset > fileSize - table.length)
+		return false;
+
+	if (!(table.flags & IndexTable::Checkpoints))
+		return true;
+
+	uint64_t remaining = indexSize - position - sizeof(IndexTable);
+	if ((table.checkpointCount == 0) != (table.count == 0) || table.checkpointCount > remaining / sizeof(IndexCheckpoint))
+		return false;
+
+	remaining -= table.checkpointCount * sizeof(IndexCheckpoint);
+	return !(table.flags & IndexTable::Object) || table.count <= remaining / sizeof(IndexKey);
+}
+
+static bool ReadCheckpoint(std::ifstream& index, uint64_t position, const IndexTable& table, uint64_t checkpoint, IndexCheckpoint& result, uint64_t& windowEnd) { //windowEnd is where the next checkpoint or the value starts
+
+	if (!ReadAt(index, position + sizeof(IndexTable) + checkpoint * sizeof(IndexCheckpoint), &result, sizeof(result)))
+		return false;
+
+	windowEnd = table.offset + table.length;
+	if (checkpoint + 1 < table.checkpointCount) {
+		IndexCheckpoint next;
+		if (!ReadAt(index, position + sizeof(IndexTable) + (checkpoint + 1) * sizeof(IndexCheckpoint), &next, sizeof(next)))
+			return false;
+
+		windowEnd = next.offset;
+	}
+
+	return result.offset >= table.offset && result.offset <= windowEnd && windowEnd <= table.offset + table.length;
+}
+
+
+bool JSON::BuildIndex(const std::string& path, uint32_t maxDepth) {
+
+	std::ifstream file(path, std::ios::binary);
+	std::ofstream index(path + ".idx", std::ios::binary | std::ios::trunc);
+	if (!file || !index)
+		return false;
+
+	IndexHeader header = {}; //Magic left zeroed so an interrupted build is never loaded
+	index.write((const char*)&header, sizeof(header));
+
+	struct Child { //How a value appears in its parent
+		uint64_t ordinal;
+		uint64_t offset; //Of the key for members
+		uint64_t valueOffset;
+		uint32_t hash; //Of the key for members
+	};
+
+	struct Frame {
+		bool isObject;
+		bool expectingKey;
+		bool indexed; //Shallower than maxDepth, gets checkpoints if it turns out big enough
+		uint64_t count;
+		Child self;
+		uint64_t memberOffset; //Key start of the current member
+		uint32_t memberHash;
+		std::vector<IndexCheckpoint> checkpoints;
+		std::vector<IndexKey> keys;
+	};
+
+	std::vector<Frame> stack;
+	std::string rawKey; //With quotes, unescaped like ParseValue does
+	std::string key;
+	uint64_t rootTable = 0;
+	bool failed = false;
+
+	bool inString = false;
+	bool stringIsKey = false;
+	bool escaped = false;
+	bool inScalar = false;
+	Child scalar = {}; //String or scalar being scanned
+
+	auto beginValue = [&](uint64_t offset) -> Child {
+		if (stack.empty())
+			return { 0, offset, offset, 0 };
+
+		Frame& parent = stack.back();
+		return { parent.count++, parent.isObject ? parent.memberOffset : offset, offset, parent.memberHash };
+	};
+
+	//Writes the table of the value if its parent references it, frame is nullptr for strings and scalars
+	auto endValue = [&](const Child& child, uint64_t end, Frame* frame) {
+		if (!stack.empty() && !stack.back().indexed)
+			return;
+
+		const uint64_t length = end - child.valueOffset;
+		uint64_t table = 0;
+		if (stack.empty() || length >= indexGranularity) {
+			IndexTable values = {};
+			values.offset = child.valueOffset;
+			values.length = length;
+
+			const bool checkpoints = frame != nullptr && frame->indexed && length >= indexGranularity;
+			if (checkpoints) {
+				values.flags = IndexTable::Checkpoints | (frame->isObject ? (uint32_t)IndexTable::Object : 0u);
+				values.count = frame->count;
+				values.checkpointCount = frame->checkpoints.size();
+			}
+
+			table = (uint64_t)index.tellp();
+			index.write((const char*)&values, sizeof(values));
+
+			if (checkpoints) {
+				index.write((const char*)frame->checkpoints.data(), frame->checkpoints.size() * sizeof(IndexCheckpoint));
+
+				std::stable_sort(frame->keys.begin(), frame->keys.end(), [](const IndexKey& a, const IndexKey& b) { //Duplicate keys stay in file order
+					return a.hash < b.hash;
+				});
+				index.write((const char*)frame->keys.data(), frame->keys.size() * sizeof(IndexKey));
+			}
+		}
+
+		if (stack.empty()) {
+			rootTable = table;
+			return;
+		}
+
+		Frame& parent = stack.back();
+		if (parent.checkpoints.empty() || table != 0 || child.offset - parent.checkpoints.back().offset >= indexGranularity)
+			parent.checkpoints.push_back({ child.ordinal, child.offset, table });
+
+		if (parent.isObject) {
+			if (parent.checkpoints.size() > UINT32_MAX) //More than 16TiB in one object
+				failed = true;
+
+			parent.keys.push_back({ child.hash, (uint32_t)(parent.checkpoints.size() - 1) });
+		}
+	};
+
+	std::string chunk(1024 * 1024, '\0');
+	uint64_t chunkOffset = 0;
+
+	while (file && !failed) {
+		file.read(&chunk[0], chunk.size());
+		const size_t count = (size_t)file.gcount();
+
+		for (size_t i = 0; i < count; ++i) {
+			const uint8_t character = chunk[i];
+			const uint64_t offset = chunkOffset + i;
+
+			if (inString) {
+				if (stringIsKey)
+					rawKey += character;
+
+				if (escaped) {
+					escaped = false;
+				}
+				else if (character == '\\') {
+					escaped = true;
+				}
+				else if (character == '"') {
+					inString = false;
+					if (stringIsKey) {
+						key.clear();
+						UnescapeString(rawKey, key);
+						stack.back().expectingKey = false;
+						stack.back().memberHash = (uint32_t)HashBytes(key);
+					}
+					else {
+						endValue(scalar, offset + 1, nullptr);
+					}
+				}
+
+				continue;
+			}
+
+			if (inScalar) {
+				if (character != ',' && character != '}' && character != ']' && character != ':' && !isspace(character))
+					continue;
+
+				inScalar = false;
+				endValue(scalar, offset, nullptr);
+			}
+
+			switch (character) {
+
+			case '"': {
+				inString = true;
+				stringIsKey = !stack.empty() && stack.back().isObject && stack.back().expectingKey;
+				if (stringIsKey) {
+					rawKey = "\"";
+					stack.back().memberOffset = offset;
+				}
+				else {
+					scalar = beginValue(offset);
+				}
+
+				break;
+			}
+
+			case '{':
+			case '[': {
+				const Child self = beginValue(offset);
+				stack.push_back({ character == '{', character == '{', stack.size() < maxDepth, 0, self, 0, 0, {}, {} });
+				break;
+			}
+
+			case '}':
+			case ']': {
+				if (stack.empty())
+					break;
+
+				Frame frame = std::move(stack.back());
+				stack.pop_back();
+				endValue(frame.self, offset + 1, &frame);
+				break;
+			}
+
+			case ',': {
+				if (!stack.empty() && stack.back().isObject)
+					stack.back().expectingKey = true;
+
+				break;
+			}
+
+			case ':':
+				break;
+
+			default: {
+				if (isspace(character))
+					break;
+
+				inScalar = true;
+				scalar = beginValue(offset);
+				break;
+			}
+			}
+		}
+
+		chunkOffset += count;
+	}
+
+	if (inScalar)
+		endValue(scalar, chunkOffset, nullptr);
+
+	if (failed || rootTable == 0)
+		return false;
+
+	memcpy(header.magic, indexMagic, sizeof(indexMagic));
+	header.version = indexVersion;
+	header.maxDepth = maxDepth;
+	header.rootTable = rootTable;
+	if (!GetFileStamp(path, file, header.fileSize, header.modificationTime, header.hash))
+		return false;
+
+	index.seekp(0);
+	index.write((const char*)&header, sizeof(header));
+
+	return (bool)index;
+}
+
+
+JSON::IndexedFile::IndexedFile(const std::string& pPath) : path(pPath), file(new std::ifstream(pPath, std::ios::binary)), index(new std::ifstream(pPath + ".idx", std::ios::binary)) {
+
+	if (!*file || !*index)
+		return;
+
+	std::error_code error;
+	indexSize = (uint64_t)std::filesystem::file_size(path + ".idx", error);
+	if (error)
+		return;
+
+	IndexHeader header;
+	if (!ReadAt(*index, 0, &header, sizeof(header)) || memcmp(header.magic, indexMagic, sizeof(indexMagic)) != 0 || header.version != indexVersion)
+		return;
+
+	//Stale if the file changed since the index was built
+	int64_t modificationTime;
+	uint64_t hash;
+	if (!GetFileStamp(path, *file, fileSize, modificationTime, hash) || fileSize != header.fileSize || modificationTime != header.modificationTime || hash != header.hash)
+		return;
+
+	rootTable = header.rootTable;
+	valid = true;
+}
+
+JSON::IndexedFile::~IndexedFile() = default;
+
+JSON::IndexedFile::IndexedFile(IndexedFile&& other) noexcept {
+	*this = std::move(other);
+}
+
+JSON::IndexedFile& JSON::IndexedFile::operator=(IndexedFile&& other) noexcept {
+
+	path = std::move(other.path);
+	file = std::move(other.file);
+	index = std::move(other.index);
+	indexSize = other.indexSize;
+	fileSize = other.fileSize;
+	rootTable = other.rootTable;
+	valid = other.valid;
+
+	other.valid = false; //Its streams are gone
+
+	return *this;
+}
+
+bool JSON::IndexedFile::Get(const std::string& pointer, Variant& value) {
+
+	if (!valid || (!pointer.empty() && pointer[0] != '/'))
+		return false;
+
+	auto readText = [&](uint64_t offset, uint64_t length, std::string& text) {
+		text.resize((size_t)length);
+		return ReadAt(*file, offset, &text[0], text.size());
+	};
+
+	auto skipSeparators = [](const std::string& text, size_t& i) {
+		while (i < text.size() && (isspace((uint8_t)text[i]) || text[i] == ',' || text[i] == ':'))
+			++i;
+	};
+
+	//Walks down the tables one pointer token at a time, until the value is small enough to have been read whole
+	uint64_t position = rootTable;
+	IndexTable table;
+	size_t resolved = 0; //Pointer bytes consumed
+	std::string text;
+	std::string name;
+
+	while (true) {
+		if (!ReadTable(*index, indexSize, fileSize, position, table))
+			return false;
+
+		if (resolved == pointer.size() || !(table.flags & IndexTable::Checkpoints)) {
+			if (!readText(table.offset, table.length, text))
+				return false;
+
+			break;
+		}
+
+		size_t end = pointer.find('/', resolved + 1);
+		if (end == std::string::npos)
+			end = pointer.size();
+
+		name.clear();
+		UnescapePointerToken(std::string_view(pointer).substr(resolved + 1, end - resolved - 1), name);
+		resolved = end;
+
+		const uint64_t checkpointsStart = position + sizeof(IndexTable);
+		uint64_t childTable = 0;
+		bool found = false;
+
+		if (table.flags & IndexTable::Object) {
+			//First member with the hash, then every one sharing it, the last match wins like in ParseJSON
+			const uint32_t hash = (uint32_t)HashBytes(name);
+			const uint64_t keysStart = checkpointsStart + table.checkpointCount * sizeof(IndexCheckpoint);
+
+			uint64_t low = 0;
+			uint64_t high = table.count;
+			while (low < high) {
+				const uint64_t middle = low + (high - low) / 2;
+				IndexKey entry;
+				if (!ReadAt(*index, keysStart + middle * sizeof(IndexKey), &entry, sizeof(entry)))
+					return false;
+
+				if (entry.hash < hash)
+					low = middle + 1;
+				else
+					high = middle;
+			}
+
+			uint64_t previousCheckpoint = UINT64_MAX;
+			for (; low < table.count; ++low) {
+				IndexKey entry;
+				if (!ReadAt(*index, keysStart + low * sizeof(IndexKey), &entry, sizeof(entry)))
+					return false;
+
+				if (entry.hash != hash)
+					break;
+
+				if (entry.checkpoint == previousCheckpoint) //Its window was already searched
+					continue;
+
+				previousCheckpoint = entry.checkpoint;
+				if (entry.checkpoint >= table.checkpointCount)
+					return false;
+
+				IndexCheckpoint checkpoint;
+				uint64_t windowEnd;
+				if (!ReadCheckpoint(*index, position, table, entry.checkpoint, checkpoint, windowEnd))
+					return false;
+
+				uint64_t windowLength = windowEnd - checkpoint.offset;
+				if (checkpoint.table != 0) { //Big member alone in its window, only its key is read
+					IndexTable member;
+					if (!ReadTable(*index, indexSize, fileSize, checkpoint.table, member) || member.offset < checkpoint.offset || member.offset > windowEnd)
+						return false;
+
+					windowLength = member.offset - checkpoint.offset;
+				}
+
+				std::string window;
+				if (!readText(checkpoint.offset, windowLength, window))
+					return false;
+
+				std::string memberKey;
+				std::string_view token;
+				size_t i = 0;
+				while (true) {
+					skipSeparators(window, i);
+					if (i >= window.size() || window[i] != '"')
+						break;
+
+					GetToken(window, i, token);
+					memberKey.clear();
+					UnescapeString(token, memberKey);
+					skipSeparators(window, i);
+
+					const bool match = memberKey == name;
+					if (checkpoint.table != 0) {
+						if (match) {
+							childTable = checkpoint.table;
+							found = true;
+						}
+
+						break;
+					}
+
+					const size_t start = i;
+					SkipValue(window, i);
+					if (match && i > start) {
+						text.assign(window, start, i - start);
+						childTable = 0;
+						found = true;
+					}
+				}
+			}
+		}
+		else {
+			size_t element;
+			if (!ParseArrayIndex(name, element) || element >= table.count)
+				return false;
+
+			//Last checkpoint at or before the element
+			uint64_t low = 0;
+			uint64_t high = table.checkpointCount;
+			while (high - low > 1) {
+				const uint64_t middle = low + (high - low) / 2;
+				IndexCheckpoint checkpoint;
+				if (!ReadAt(*index, checkpointsStart + middle * sizeof(IndexCheckpoint), &checkpoint, sizeof(checkpoint)))
+					return false;
+
+				if (checkpoint.ordinal <= element)
+					low = middle;
+				else
+					high = middle;
+			}
+
+			IndexCheckpoint checkpoint;
+			uint64_t windowEnd;
+			if (!ReadCheckpoint(*index, position, table, low, checkpoint, windowEnd) || checkpoint.ordinal > element)
+				return false;
+
+			if (checkpoint.ordinal == element && checkpoint.table != 0) {
+				childTable = checkpoint.table;
+				found = true;
+			}
+			else if (checkpoint.table == 0) { //Every element in the window is small, skip to it
+				std::string window;
+				if (!readText(checkpoint.offset, windowEnd - checkpoint.offset, window))
+					return false;
+
+				size_t i = 0;
+				for (uint64_t skipped = checkpoint.ordinal; skipped < element && i < window.size(); ++skipped) {
+					skipSeparators(window, i);
+					SkipValue(window, i);
+				}
+
+				skipSeparators(window, i);
+				const size_t start = i;
+				SkipValue(window, i);
+				if (i > start && window[start] != ']') {
+					text.assign(window, start, i - start);
+					found = true;
+				}
+			}
+		}
+
+		if (!found)
+			return false;
+
+		if (childTable == 0)
+			break;
+
+		position = childTable;
+	}
+
+	Variant container = std::vector<Variant>();
+	auto& vector = *(std::vector<Variant>*)container.GetData();
+
+	size_t index = 0;
+	ParseValue(container, text, index);
+	if (vector.empty())
+		return false;
+
+	if (resolved == pointer.size()) {
+		value = std::move(vector[0]);
+		return true;
+	}
+
+	Variant* child = ResolvePointer(vector[0], std::string_view(pointer).substr(resolved));
+	if (child == nullptr)
+		return false;
+
+	value = std::move(*child);
+	return true;
+}
@@ -0,0 +1,453 @@
+#include "JSON.hpp"
+
+#include <algorithm>
+
+//RFC 6902 JSON Patch over Variant trees, paths are RFC 6901 JSON Pointers
+
+static constexpr JSON::Key opKey = "op";
+static constexpr JSON::Key pathKey = "path";
+static constexpr JSON::Key fromKey = "from";
+static constexpr JSON::Key valueKey = "value";
+
+
+std::vector<Variant> JSON::Diff(const std::unordered_map<std::string, Variant>& from, const std::unordered_map<std::string, Variant>& to) {
+
+	std::vector<Variant> patch;
+	std::string path;
+
+	Variant fromVariant = (std::unordered_map<std::string, Variant>*)&from;
+	Variant toVariant = (std::unordered_map<std::string, Variant>*)&to;
+	DiffValue(fromVariant, toVariant, path, patch);
+
+	return patch;
+}
+
+bool JSON::ApplyPatch(std::unordered_map<std::string, Variant>& map, const std::vector<Variant>& patch) {
+
+	Variant root = &map;
+
+	for (const Variant& operation : patch) {
+		const Variant* op = Find(operation, opKey);
+		const Variant* path = Find(operation, pathKey);
+		if (op == nullptr || path == nullptr || op->GetType() != Variant::String || path->GetType() != Variant::String)
+			return false;
+
+		const std::string& opName = *(std::string*)op->GetData();
+		const std::string& pointer = *(std::string*)path->GetData();
+		const Variant* value = Find(operation, valueKey);
+
+		if (opName == "add") {
+			if (value == nullptr || !AddValue(root, pointer, Variant(*value)))
+				return false;
+		}
+		else if (opName == "remove") {
+			if (!RemoveValue(root, pointer, nullptr))
+				return false;
+		}
+		else if (opName == "replace") {
+			Variant* target = ResolvePointer(root, pointer);
+			if (value == nullptr || target == nullptr)
+				return false;
+
+			if (target == &root) { //Whole document, must stay a dictionary
+				if (value->GetType() != Variant::Dictionary)
+					return false;
+
+				map = *(std::unordered_map<std::string, Variant>*)value->GetData();
+			}
+			else {
+				*target = *value;
+			}
+		}
+		else if (opName == "move" || opName == "copy") {
+			const Variant* from = Find(operation, fromKey);
+			if (from == nullptr || from->GetType() != Variant::String)
+				return false;
+
+			const std::string& fromPointer = *(std::string*)from->GetData();
+
+			if (opName == "move") {
+				if (fromPointer == pointer)
+					continue;
+
+				if (pointer.size() > fromPointer.size() && pointer.compare(0, fromPointer.size(), fromPointer) == 0 && pointer[fromPointer.size()] == '/') //Can't move a value into one of its children
+					return false;
+
+				Variant moved;
+				if (!RemoveValue(root, fromPointer, &moved) || !AddValue(root, pointer, std::move(moved)))
+					return false;
+			}
+			else {
+				Variant* source = ResolvePointer(root, fromPointer);
+				if (source == nullptr || !AddValue(root, pointer, Variant(*source)))
+					return false;
+			}
+		}
+		else if (opName == "test") {
+			Variant* target = ResolvePointer(root, pointer);
+			if (value == nullptr || target == nullptr || !Equals(*target, *value))
+				return false;
+		}
+		else {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+bool JSON::Equals(const Variant& a, const Variant& b) {
+
+	if (a.GetType() != b.GetType()) {
+		//Numbers compare by value, 1 and 1.0 are the same JSON number
+		if (a.GetType() == Variant::Int && b.GetType() == Variant::Float)
+			return (double)int64_t(a) == double(b);
+		if (a.GetType() == Variant::Float && b.GetType() == Variant::Int)
+			return double(a) == (double)int64_t(b);
+
+		return false;
+	}
+
+	switch (a.GetType()) {
+
+	case Variant::Pointer:
+		return a.GetData() == b.GetData();
+
+	case Variant::Bool:
+		return bool(a) == bool(b);
+
+	case Variant::Int:
+		return int64_t(a) == int64_t(b);
+
+	case Variant::Float:
+		return double(a) == double(b);
+
+	default:
+		break;
+	}
+
+	if (a.GetData() == b.GetData()) //Same storage, no need to walk it
+		return true;
+
+	switch (a.GetType()) {
+
+	case Variant::String:
+		return *(std::string*)a.GetData() == *(std::string*)b.GetData();
+
+	case Variant::PointerArray:
+		return *(std::vector<void*>*)a.GetData() == *(std::vector<void*>*)b.GetData();
+
+	case Variant::BoolArray:
+		return *(std::vector<bool>*)a.GetData() == *(std::vector<bool>*)b.GetData();
+
+	case Variant::ByteArray:
+		return *(std::vector<uint8_t>*)a.GetData() == *(std::vector<uint8_t>*)b.GetData();
+
+	case Variant::IntArray:
+		return *(std::vector<int64_t>*)a.GetData() == *(std::vector<int64_t>*)b.GetData();
+
+	case Variant::FloatArray:
+		return *(std::vector<double>*)a.GetData() == *(std::vector<double>*)b.GetData();
+
+	case Variant::StringArray:
+		return *(std::vector<std::string>*)a.GetData() == *(std::vector<std::string>*)b.GetData();
+
+	case Variant::VariantArray: {
+		auto& aVector = *(std::vector<Variant>*)a.GetData();
+		auto& bVector = *(std::vector<Variant>*)b.GetData();
+		if (aVector.size() != bVector.size())
+			return false;
+
+		for (size_t i = 0; i < aVector.size(); ++i) {
+			if (!Equals(aVector[i], bVector[i]))
+				return false;
+		}
+
+		return true;
+	}
+
+	case Variant::Dictionary: {
+		auto& aMap = *(std::unordered_map<std::string, Variant>*)a.GetData();
+		auto& bMap = *(std::unordered_map<std::string, Variant>*)b.GetData();
+		if (aMap.size() != bMap.size())
+			return false;
+
+		for (auto& element : aMap) {
+			auto it = bMap.find(element.first);
+			if (it == bMap.end() || !Equals(element.second, it->second))
+				return false;
+		}
+
+		return true;
+	}
+
+	default:
+		return false;
+	}
+}
+
+
+void JSON::DiffValue(const Variant& from, const Variant& to, std::string& path, std::vector<Variant>& patch) {
+
+	//Containers are only skipped when they share storage, comparing them in full first would walk every subtree again at each depth
+	const size_t pathSize = path.size();
+
+	if (from.GetType() == Variant::Dictionary && to.GetType() == Variant::Dictionary) {
+		if (from.GetData() == to.GetData())
+			return;
+
+		auto& fromMap = *(std::unordered_map<std::string, Variant>*)from.GetData();
+		auto& toMap = *(std::unordered_map<std::string, Variant>*)to.GetData();
+
+		for (auto& element : fromMap) {
+			AppendPointerToken(path, element.first);
+
+			auto it = toMap.find(element.first);
+			if (it == toMap.end())
+				PushOperation(patch, "remove", path, nullptr);
+			else
+				DiffValue(element.second, it->second, path, patch);
+
+			path.resize(pathSize);
+		}
+
+		for (auto& element : toMap) {
+			if (fromMap.find(element.first) != fromMap.end())
+				continue;
+
+			AppendPointerToken(path, element.first);
+			PushOperation(patch, "add", path, &element.second);
+			path.resize(pathSize);
+		}
+
+		return;
+	}
+
+	if (from.GetType() == Variant::VariantArray && to.GetType() == Variant::VariantArray) {
+		if (from.GetData() == to.GetData())
+			return;
+
+		auto& fromVector = *(std::vector<Variant>*)from.GetData();
+		auto& toVector = *(std::vector<Variant>*)to.GetData();
+
+		const size_t common = std::min(fromVector.size(), toVector.size());
+		for (size_t i = 0; i < common; ++i) {
+			AppendPointerToken(path, std::to_string(i));
+			DiffValue(fromVector[i], toVector[i], path, patch);
+			path.resize(pathSize);
+		}
+
+		for (size_t i = common; i < toVector.size(); ++i) {
+			AppendPointerToken(path, std::to_string(i));
+			PushOperation(patch, "add", path, &toVector[i]);
+			path.resize(pathSize);
+		}
+
+		for (size_t i = fromVector.size(); i > common; --i) { //Remove from the back so the remaining indices stay valid
+			AppendPointerToken(path, std::to_string(i - 1));
+			PushOperation(patch, "remove", path, nullptr);
+			path.resize(pathSize);
+		}
+
+		return;
+	}
+
+	if (!Equals(from, to)) //Scalars, strings and packed arrays
+		PushOperation(patch, "replace", path, &to);
+}
+
+void JSON::PushOperation(std::vector<Variant>& patch, const char* op, const std::string& path, const Variant* value) {
+
+	patch.push_back(std::unordered_map<std::string, Variant>());
+	auto& operation = *(std::unordered_map<std::string, Variant>*)patch.back().GetData();
+
+	operation["op"] = op;
+	operation["path"] = path;
+	if (value != nullptr)
+		operation["value"] = *value;
+}
+
+void JSON::AppendPointerToken(std::string& path, const std::string_view& token) {
+
+	path += '/';
+	for (const char c : token) { //Escape as ~0 and ~1
+		if (c == '~')
+			path += "~0";
+		else if (c == '/')
+			path += "~1";
+		else
+			path += c;
+	}
+}
+
+
+void JSON::UnescapePointerToken(const std::string_view& token, std::string& string) { //Appends
+
+	//Unescape ~1 and ~0, in that order
+	for (size_t i = 0; i < token.size(); ++i) {
+		if (token[i] == '~' && i + 1 < token.size() && (token[i + 1] == '0' || token[i + 1] == '1')) {
+			string += token[i + 1] == '0' ? '~' : '/';
+			++i;
+		}
+		else {
+			string += token[i];
+		}
+	}
+}
+
+
+Variant* JSON::ResolvePointer(Variant& root, const std::string_view& pointer) {
+
+	if (pointer.empty())
+		return &root;
+
+	std::string key;
+	Variant* parent = ResolveParent(root, pointer, key);
+	if (parent == nullptr)
+		return nullptr;
+
+	return GetChild(*parent, key);
+}
+
+Variant* JSON::ResolveParent(Variant& root, const std::string_view& pointer, std::string& lastToken) {
+
+	if (pointer.empty() || pointer[0] != '/')
+		return nullptr;
+
+	Variant* current = &root;
+	size_t i = 1;
+	while (true) {
+		size_t end = pointer.find('/', i);
+		if (end == std::string_view::npos)
+			end = pointer.size();
+
+		lastToken.clear();
+		UnescapePointerToken(pointer.substr(i, end - i), lastToken);
+
+		if (end == pointer.size())
+			return current;
+
+		current = GetChild(*current, lastToken);
+		if (current == nullptr)
+			return nullptr;
+
+		i = end + 1;
+	}
+}
+
+Variant* JSON::GetChild(Variant& container, const std::string& token) {
+
+	if (container.GetType() == Variant::Dictionary) {
+		auto& map = *(std::unordered_map<std::string, Variant>*)container.GetData();
+		auto it = map.find(token);
+		return it != map.end() ? &it->second : nullptr;
+	}
+
+	if (container.GetType() == Variant::VariantArray) { //Packed arrays aren't addressable since their elements aren't variants
+		auto& vector = *(std::vector<Variant>*)container.GetData();
+		size_t index;
+		if (!ParseArrayIndex(token, index) || index >= vector.size())
+			return nullptr;
+
+		return &vector[index];
+	}
+
+	return nullptr;
+}
+
+bool JSON::ParseArrayIndex(const std::string_view& token, size_t& index) {
+
+	if (token.empty() || (token.size() > 1 && token[0] == '0')) //No leading zeros
+		return false;
+
+	index = 0;
+	for (const char c : token) {
+		if (!isdigit((uint8_t)c))
+			return false;
+
+		if (index > (SIZE_MAX - (c - '0')) / 10) //Would wrap around to a small index
+			return false;
+
+		index = index * 10 + (c - '0');
+	}
+
+	return true;
+}
+
+
+bool JSON::AddValue(Variant& root, const std::string_view& pointer, Variant&& value) {
+
+	if (pointer.empty()) { //Whole document, must stay a dictionary
+		if (value.GetType() != Variant::Dictionary)
+			return false;
+
+		auto& map = *(std::unordered_map<std::string, Variant>*)root.GetData();
+		map = std::move(*(std::unordered_map<std::string, Variant>*)value.GetData());
+		return true;
+	}
+
+	std::string key;
+	Variant* parent = ResolveParent(root, pointer, key);
+	if (parent == nullptr)
+		return false;
+
+	if (parent->GetType() == Variant::Dictionary) {
+		auto& map = *(std::unordered_map<std::string, Variant>*)parent->GetData();
+		map[key] = std::move(value);
+		return true;
+	}
+
+	if (parent->GetType() == Variant::VariantArray) {
+		auto& vector = *(std::vector<Variant>*)parent->GetData();
+		if (key == "-") {
+			vector.push_back(std::move(value));
+			return true;
+		}
+
+		size_t index;
+		if (!ParseArrayIndex(key, index) || index > vector.size())
+			return false;
+
+		vector.insert(vector.begin() + index, std::move(value));
+		return true;
+	}
+
+	return false;
+}
+
+bool JSON::RemoveValue(Variant& root, const std::string_view& pointer, Variant* removed) {
+
+	std::string key;
+	Variant* parent = ResolveParent(root, pointer, key);
+	if (parent == nullptr)
+		return false;
+
+	if (parent->GetType() == Variant::Dictionary) {
+		auto& map = *(std::unordered_map<std::string, Variant>*)parent->GetData();
+		auto it = map.find(key);
+		if (it == map.end())
+			return false;
+
+		if (removed != nullptr)
+			*removed = std::move(it->second);
+
+		map.erase(it);
+		return true;
+	}
+
+	if (parent->GetType() == Variant::VariantArray) {
+		auto& vector = *(std::vector<Variant>*)parent->GetData();
+		size_t index;
+		if (!ParseArrayIndex(key, index) || index >= vector.size())
+			return false;
+
+		if (removed != nullptr)
+			*removed = std::move(vector[index]);
+
+		vector.erase(vector.begin() + index);
+		return true;
+	}
+
+	return false;
+}
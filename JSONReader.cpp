@@ -0,0 +1,224 @@
+#include "JSON.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+
+//Windowed reading of the values of a top level container, shared by ArrayReader and ObjectReader
+class JSON::StreamReader {
+
+public:
+
+	StreamReader(const std::string_view& buffer, char pOpen) : view(buffer), open(pOpen), exhausted(true), container(std::vector<Variant>()) {}
+	StreamReader(std::unique_ptr<Source> pSource, char pOpen) : source(std::move(pSource)), open(pOpen), container(std::vector<Variant>()) {}
+
+	StreamReader(const StreamReader&) = delete; //Only ever owned through a pointer, the view can point into the window
+	StreamReader& operator=(const StreamReader&) = delete;
+
+	bool Next(std::string* key, Variant& element); //Keys are read for objects only
+
+private:
+
+	static constexpr size_t ChunkSize = 64 * 1024;
+
+	bool SkipSeparator(char separator); //Whitespace plus separator, 0 for none
+	void FindValueEnd(size_t& start);
+	bool Fill(size_t& start); //Reads more input keeping the bytes from start onwards, which are moved to the front of the window
+
+	std::unique_ptr<Source> source;
+	std::string window; //Input not consumed yet, only used with a source
+	std::string_view view;
+	size_t index = 0;
+	char open; //'[' or '{'
+	bool started = false;
+	bool finished = false;
+	bool exhausted = false; //Source returned 0
+
+	Variant container; //Reused array that ParseValue writes each element into
+};
+
+
+class FileSource : public JSON::Source {
+
+public:
+
+	FileSource(const std::string& path) : file(path, std::ios::binary) {}
+
+	size_t Read(char* data, size_t size) override {
+		if (!file)
+			return 0;
+
+		file.read(data, size);
+		return (size_t)file.gcount();
+	}
+
+private:
+
+	std::ifstream file;
+};
+
+
+JSON::ArrayReader::ArrayReader(const std::string_view& buffer) : reader(new StreamReader(buffer, '[')) {}
+
+JSON::ArrayReader::ArrayReader(std::unique_ptr<Source> source) : reader(new StreamReader(std::move(source), '[')) {}
+
+JSON::ArrayReader::~ArrayReader() = default;
+
+JSON::ArrayReader::ArrayReader(ArrayReader&& other) noexcept = default;
+
+JSON::ArrayReader& JSON::ArrayReader::operator=(ArrayReader&& other) noexcept = default;
+
+JSON::ArrayReader JSON::ArrayReader::FromFile(const std::string& path) {
+	return ArrayReader(std::make_unique<FileSource>(path));
+}
+
+bool JSON::ArrayReader::Next(Variant& element) {
+	return reader != nullptr && reader->Next(nullptr, element); //Null once moved from
+}
+
+
+JSON::ObjectReader::ObjectReader(const std::string_view& buffer) : reader(new StreamReader(buffer, '{')) {}
+
+JSON::ObjectReader::ObjectReader(std::unique_ptr<Source> source) : reader(new StreamReader(std::move(source), '{')) {}
+
+JSON::ObjectReader::~ObjectReader() = default;
+
+JSON::ObjectReader::ObjectReader(ObjectReader&& other) noexcept = default;
+
+JSON::ObjectReader& JSON::ObjectReader::operator=(ObjectReader&& other) noexcept = default;
+
+JSON::ObjectReader JSON::ObjectReader::FromFile(const std::string& path) {
+	return ObjectReader(std::make_unique<FileSource>(path));
+}
+
+bool JSON::ObjectReader::Next(std::string& key, Variant& value) {
+	return reader != nullptr && reader->Next(&key, value);
+}
+
+
+bool JSON::StreamReader::Next(std::string* key, Variant& element) {
+
+	if (finished)
+		return false;
+
+	const bool isObject = open == '{';
+
+	if (!started) {
+		if (!SkipSeparator(0) || view[index] != open) { //Not the expected container
+			finished = true;
+			return false;
+		}
+
+		++index;
+		started = true;
+	}
+
+	if (!SkipSeparator(',') || view[index] == (isObject ? '}' : ']')) {
+		finished = true;
+		return false;
+	}
+
+	if (isObject) {
+		if (view[index] != '"') {
+			finished = true;
+			return false;
+		}
+
+		size_t start = index;
+		FindValueEnd(start);
+
+		key->clear();
+		UnescapeString(view.substr(start, index - start), *key);
+
+		if (!SkipSeparator(':')) {
+			finished = true;
+			return false;
+		}
+	}
+
+	size_t start = index;
+	FindValueEnd(start);
+
+	auto& vector = *(std::vector<Variant>*)container.GetData();
+	vector.clear();
+
+	size_t elementIndex = 0;
+	ParseValue(container, view.substr(start, index - start), elementIndex);
+
+	if (vector.empty()) { //Malformed element
+		finished = true;
+		return false;
+	}
+
+	element = std::move(vector[0]);
+	vector.clear();
+
+	return true;
+}
+
+bool JSON::StreamReader::SkipSeparator(char separator) {
+
+	//Reading more as needed
+	while (true) {
+		for (; index < view.size(); ++index) {
+			const uint8_t character = view[index];
+			if (!isspace(character) && (separator == 0 || character != separator))
+				return true;
+		}
+
+		size_t start = index;
+		if (!Fill(start))
+			return false;
+
+		index = start;
+	}
+}
+
+void JSON::StreamReader::FindValueEnd(size_t& start) {
+
+	//Reads more until the value is complete, start is updated if the window moves
+	while (true) {
+		index = start;
+		SkipValue(view, index);
+
+		if (index < view.size() || exhausted) //Anything ending right at the window end could still continue
+			return;
+
+		if (!Fill(start)) {
+			index = view.size();
+			return;
+		}
+	}
+}
+
+
+bool JSON::StreamReader::Fill(size_t& start) {
+
+	if (exhausted)
+		return false;
+
+	//Drop what was already consumed, then read at least as much as is kept so rescans of big elements stay linear overall
+	window.erase(0, start);
+	start = 0;
+
+	const size_t kept = window.size();
+	const size_t size = std::max(ChunkSize, kept);
+	window.resize(kept + size);
+
+	//Sources can return less than asked (Example: One ring chunk), keep reading so the window really doubles
+	size_t count = 0;
+	while (count < size) {
+		const size_t readCount = source->Read(&window[kept + count], size - count);
+		if (readCount == 0) {
+			exhausted = true;
+			break;
+		}
+
+		count += readCount;
+	}
+
+	window.resize(kept + count);
+	view = window;
+
+	return count > 0;
+}
@@ -0,0 +1,284 @@
+#include "JSON.hpp"
+
+static constexpr JSON::Key typeKey = "type";
+static constexpr JSON::Key enumKey = "enum";
+static constexpr JSON::Key minimumKey = "minimum";
+static constexpr JSON::Key maximumKey = "maximum";
+static constexpr JSON::Key exclusiveMinimumKey = "exclusiveMinimum";
+static constexpr JSON::Key exclusiveMaximumKey = "exclusiveMaximum";
+static constexpr JSON::Key propertiesKey = "properties";
+static constexpr JSON::Key requiredKey = "required";
+static constexpr JSON::Key itemsKey = "items";
+
+
+JSON::Schema::Schema(const std::unordered_map<std::string, Variant>& schema) {
+
+	Variant variant = (std::unordered_map<std::string, Variant>*)&schema;
+	Compile(variant, root);
+}
+
+void JSON::Schema::Compile(const Variant& schema, Node& node) {
+
+	if (const Variant* type = Find(schema, typeKey)) {
+		std::vector<std::string> names;
+		if (type->GetType() == Variant::String)
+			names.push_back(std::string(*type));
+		else
+			names = std::vector<std::string>(*type);
+
+		node.types = 0;
+		for (const std::string& name : names) {
+			if (name == "null")
+				node.types |= NullType;
+			else if (name == "boolean")
+				node.types |= BoolType;
+			else if (name == "integer")
+				node.types |= IntegerType;
+			else if (name == "number")
+				node.types |= NumberType;
+			else if (name == "string")
+				node.types |= StringType;
+			else if (name == "array")
+				node.types |= ArrayType;
+			else if (name == "object")
+				node.types |= ObjectType;
+		}
+	}
+
+	if (const Variant* values = Find(schema, enumKey))
+		node.enumValues = std::vector<Variant>(*values);
+
+	if (const Variant* minimum = Find(schema, minimumKey)) {
+		node.hasMinimum = true;
+		node.minimum = double(*minimum);
+	}
+
+	if (const Variant* maximum = Find(schema, maximumKey)) {
+		node.hasMaximum = true;
+		node.maximum = double(*maximum);
+	}
+
+	//Draft 4 booleans make minimum/maximum exclusive, later drafts give a bound of their own and the stricter one applies
+	if (const Variant* minimum = Find(schema, exclusiveMinimumKey)) {
+		if (minimum->GetType() == Variant::Bool) {
+			node.exclusiveMinimum = bool(*minimum) && node.hasMinimum;
+		}
+		else if ((minimum->GetType() == Variant::Int || minimum->GetType() == Variant::Float) && (!node.hasMinimum || double(*minimum) >= node.minimum)) {
+			node.hasMinimum = true;
+			node.exclusiveMinimum = true;
+			node.minimum = double(*minimum);
+		}
+	}
+
+	if (const Variant* maximum = Find(schema, exclusiveMaximumKey)) {
+		if (maximum->GetType() == Variant::Bool) {
+			node.exclusiveMaximum = bool(*maximum) && node.hasMaximum;
+		}
+		else if ((maximum->GetType() == Variant::Int || maximum->GetType() == Variant::Float) && (!node.hasMaximum || double(*maximum) <= node.maximum)) {
+			node.hasMaximum = true;
+			node.exclusiveMaximum = true;
+			node.maximum = double(*maximum);
+		}
+	}
+
+	if (const Variant* properties = Find(schema, propertiesKey)) {
+		if (properties->GetType() == Variant::Dictionary) {
+			auto& map = *(std::unordered_map<std::string, Variant>*)properties->GetData();
+			node.properties.resize(map.size());
+
+			size_t i = 0;
+			for (auto& element : map) {
+				node.properties[i].key = element.first;
+				Compile(element.second, node.properties[i]);
+				++i;
+			}
+		}
+	}
+
+	if (const Variant* required = Find(schema, requiredKey))
+		node.required = std::vector<std::string>(*required);
+
+	if (const Variant* items = Find(schema, itemsKey)) {
+		node.items.resize(1);
+		Compile(*items, node.items[0]);
+	}
+}
+
+const JSON::Schema::Node* JSON::Schema::Node::FindProperty(const std::string_view& name) const {
+
+	for (const Node& property : properties) {
+		if (property.key == name)
+			return &property;
+	}
+
+	return nullptr;
+}
+
+
+bool JSON::ParseJSON(const std::string& string, const Schema& schema, std::unordered_map<std::string, Variant>& map, size_t& errorOffset) {
+
+	map.clear();
+
+	size_t i;
+	for (i = 0; i < string.size(); ++i) {
+		const uint8_t c = string[i];
+		if (c == '{') {
+			++i; //Skip it
+			break;
+		}
+	}
+
+	if (!(schema.root.types & Schema::ObjectType)) {
+		errorOffset = 0;
+		return false;
+	}
+
+	Variant variant = &map;
+	if (!ParseValue(variant, string, i, nullptr, &schema.root)) {
+		errorOffset = i;
+		return false;
+	}
+
+	if (!schema.root.enumValues.empty() && !CheckSchema(variant, schema.root)) {
+		errorOffset = i;
+		return false;
+	}
+
+	return true;
+}
+
+
+bool JSON::CheckSchema(Variant& variant, const Schema::Node& schema) {
+
+	switch (variant.GetType()) {
+
+	case Variant::Pointer:
+		if (!(schema.types & Schema::NullType))
+			return false;
+
+		break;
+
+	case Variant::Bool:
+		if (!(schema.types & Schema::BoolType))
+			return false;
+
+		break;
+
+	case Variant::Int: {
+		if (!(schema.types & (Schema::IntegerType | Schema::NumberType)))
+			return false;
+
+		if (!(schema.types & Schema::IntegerType)) //Plain "number", stored as Float up front
+			variant = (double)int64_t(variant);
+
+		break;
+	}
+
+	case Variant::Float: {
+		if (schema.types & Schema::NumberType)
+			break;
+
+		//1.0 is a valid "integer" as per JSON Schema
+		const double number = double(variant);
+		if (!(schema.types & Schema::IntegerType) || std::trunc(number) != number || std::fabs(number) > 9007199254740992.0)
+			return false;
+
+		variant = (int64_t)number;
+		break;
+	}
+
+	case Variant::String:
+		if (!(schema.types & Schema::StringType))
+			return false;
+
+		break;
+
+	case Variant::Dictionary:
+		if (!(schema.types & Schema::ObjectType))
+			return false;
+
+		break;
+
+	default: //Arrays
+		if (!(schema.types & Schema::ArrayType))
+			return false;
+
+		break;
+	}
+
+	if ((schema.hasMinimum || schema.hasMaximum) && (variant.GetType() == Variant::Int || variant.GetType() == Variant::Float)) {
+		const double number = double(variant);
+
+		if (schema.hasMinimum && (schema.exclusiveMinimum ? number <= schema.minimum : number < schema.minimum))
+			return false;
+
+		if (schema.hasMaximum && (schema.exclusiveMaximum ? number >= schema.maximum : number > schema.maximum))
+			return false;
+	}
+
+	if (!schema.enumValues.empty()) {
+		bool found = false;
+		for (const Variant& value : schema.enumValues) {
+			if (Equals(variant, value)) {
+				found = true;
+				break;
+			}
+		}
+
+		if (!found)
+			return false;
+	}
+
+	return true;
+}
+
+Variant JSON::MakeArray(const Schema::Node& schema) {
+
+	if (schema.items.empty() || !schema.items[0].enumValues.empty()) //Enums compare against variants, keep them
+		return std::vector<Variant>();
+
+	switch (schema.items[0].types) {
+
+	case Schema::BoolType:
+		return std::vector<bool>();
+
+	case Schema::IntegerType:
+		return std::vector<int64_t>();
+
+	case Schema::NumberType:
+	case Schema::NumberType | Schema::IntegerType:
+		return std::vector<double>();
+
+	case Schema::StringType:
+		return std::vector<std::string>();
+
+	default:
+		return std::vector<Variant>();
+	}
+}
+
+void JSON::PutPacked(Variant& container, Variant& variant) {
+
+	//Element types were already checked and coerced against the items schema
+	switch (container.GetType()) {
+
+	case Variant::BoolArray:
+		((std::vector<bool>*)container.GetData())->push_back(bool(variant));
+		break;
+
+	case Variant::IntArray:
+		((std::vector<int64_t>*)container.GetData())->push_back(int64_t(variant));
+		break;
+
+	case Variant::FloatArray:
+		((std::vector<double>*)container.GetData())->push_back(double(variant));
+		break;
+
+	case Variant::StringArray:
+		((std::vector<std::string>*)container.GetData())->push_back(std::move(*(std::string*)variant.GetData()));
+		break;
+
+	default:
+		break;
+	}
+}
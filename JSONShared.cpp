@@ -0,0 +1,123 @@
+#include "JSONShared.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+
+JSON::SharedDocument::SharedDocument() : current(new std::unordered_map<std::string, Variant>()) {}
+
+JSON::SharedDocument::SharedDocument(std::unordered_map<std::string, Variant> map) : current(new std::unordered_map<std::string, Variant>(std::move(map))) {}
+
+JSON::SharedDocument::~SharedDocument() {
+
+	for (std::future<void>& reload : reloads) //They publish into this document
+		reload.wait();
+
+	delete current.load();
+
+	for (const auto* document : retired)
+		delete document;
+}
+
+
+JSON::SharedDocument::Snapshot JSON::SharedDocument::GetSnapshot() const {
+
+	//Wait free: a bounded number of attempts to claim a hazard slot and publish the current document on it, then the pinned fallback
+	static constexpr size_t PublishAttempts = 4;
+
+	const std::unordered_map<std::string, Variant>* document = current.load();
+
+	//Claim a free hazard slot by publishing the document on it, starting from a per thread position to spread readers
+	thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+	for (size_t i = 0; i < JSON_SHARED_DOCUMENT_SLOTS; ++i) {
+		HazardSlot& slot = hazards[(hint + i) % JSON_SHARED_DOCUMENT_SLOTS];
+
+		const std::unordered_map<std::string, Variant>* expected = nullptr;
+		if (slot.document.load(std::memory_order_relaxed) != nullptr || !slot.document.compare_exchange_strong(expected, document))
+			continue;
+
+		hint = (hint + i) % JSON_SHARED_DOCUMENT_SLOTS;
+
+		//The document could have been retired before the hazard was visible, publish again until it's still the current one
+		for (size_t attempt = 0; attempt < PublishAttempts; ++attempt) {
+			const std::unordered_map<std::string, Variant>* latest = current.load();
+			if (latest == document)
+				return Snapshot(&slot.document, nullptr, document);
+
+			document = latest;
+			slot.document.store(document);
+		}
+
+		slot.document.store(nullptr); //Reloads keep outrunning the reader
+		break;
+	}
+
+	//Every slot taken (Example: A thread holding more snapshots than JSON_SHARED_DOCUMENT_SLOTS) or too much contention, pin the whole document instead
+	pinnedReaders.fetch_add(1);
+	return Snapshot(nullptr, &pinnedReaders, current.load());
+}
+
+
+void JSON::SharedDocument::Publish(std::unordered_map<std::string, Variant> map) {
+
+	const auto* document = new std::unordered_map<std::string, Variant>(std::move(map));
+	const auto* previous = current.exchange(document);
+
+	std::lock_guard<std::mutex> lock(writerMutex);
+	retired.push_back(previous);
+	Reclaim();
+}
+
+void JSON::SharedDocument::Reload(const std::string& string) {
+	Publish(ParseJSON(string));
+}
+
+std::future<void> JSON::SharedDocument::ReloadAsync(std::string string) {
+
+	std::promise<void> promise;
+	std::future<void> future = promise.get_future();
+
+	std::lock_guard<std::mutex> lock(writerMutex);
+
+	//The destructor waits on the ones still running, finished ones are dropped here
+	reloads.erase(std::remove_if(reloads.begin(), reloads.end(), [](const std::future<void>& reload) {
+		return reload.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}), reloads.end());
+
+	reloads.push_back(std::async(std::launch::async, [this, promise = std::move(promise), string = std::move(string)]() mutable {
+		Reload(string);
+		promise.set_value();
+	}));
+
+	return future;
+}
+
+
+void JSON::SharedDocument::Reclaim() {
+
+	//Pinned snapshots don't say which document they hold, so everything waits for a later publish (Checked after the swap, a reader pinning later can only see the new document)
+	if (pinnedReaders.load() > 0)
+		return;
+
+	//Documents still published on a hazard slot are kept for a later publish
+	auto isReferenced = [this](const std::unordered_map<std::string, Variant>* document) {
+		for (const HazardSlot& slot : hazards) {
+			if (slot.document.load() == document)
+				return true;
+		}
+
+		return false;
+	};
+
+	auto it = std::remove_if(retired.begin(), retired.end(), [&](const std::unordered_map<std::string, Variant>* document) {
+		if (isReferenced(document))
+			return false;
+
+		delete document;
+		return true;
+	});
+
+	retired.erase(it, retired.end());
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "JSON.hpp"
+
+#include <atomic>
+#include <future>
+#include <mutex>
+
+#ifndef JSON_SHARED_DOCUMENT_SLOTS
+#define JSON_SHARED_DOCUMENT_SLOTS 64 //Snapshots per SharedDocument that only hold back their own document, further ones hold back reclamation until released
+#endif
+
+
+//Document shared between threads: readers take snapshots in a bounded number of steps, reloads publish a new immutable tree with an atomic swap and old trees are reclaimed once no hazard slot references them
+class JSON::SharedDocument {
+
+public:
+
+	class Snapshot { //Keeps the document it was taken from alive until destroyed
+
+	public:
+
+		Snapshot(Snapshot&& other) noexcept : slot(other.slot), pins(other.pins), document(other.document) {
+			other.slot = nullptr;
+			other.pins = nullptr;
+		}
+
+		Snapshot(const Snapshot&) = delete;
+		Snapshot& operator=(const Snapshot&) = delete;
+		Snapshot& operator=(Snapshot&&) = delete;
+
+		~Snapshot() {
+			if (slot != nullptr)
+				slot->store(nullptr, std::memory_order_release);
+
+			if (pins != nullptr)
+				pins->fetch_sub(1);
+		}
+
+		const std::unordered_map<std::string, Variant>& operator*() const {
+			return *document;
+		}
+
+		const std::unordered_map<std::string, Variant>* operator->() const {
+			return document;
+		}
+
+	private:
+
+		friend class SharedDocument;
+
+		Snapshot(std::atomic<const std::unordered_map<std::string, Variant>*>* pSlot, std::atomic<uint32_t>* pPins, const std::unordered_map<std::string, Variant>* pDocument) : slot(pSlot), pins(pPins), document(pDocument) {}
+
+		std::atomic<const std::unordered_map<std::string, Variant>*>* slot;
+		std::atomic<uint32_t>* pins; //Set instead of slot when every hazard slot was taken
+		const std::unordered_map<std::string, Variant>* document;
+	};
+
+
+	SharedDocument();
+	explicit SharedDocument(std::unordered_map<std::string, Variant> map);
+	~SharedDocument(); //Waits for pending reloads, no snapshot may outlive it
+
+	SharedDocument(const SharedDocument&) = delete;
+	SharedDocument& operator=(const SharedDocument&) = delete;
+
+	Snapshot GetSnapshot() const;
+
+	void Publish(std::unordered_map<std::string, Variant> map);
+	void Reload(const std::string& string); //Parses on the calling thread, then publishes
+	std::future<void> ReloadAsync(std::string string); //Parses on another thread, then publishes
+
+private:
+
+	struct alignas(64) HazardSlot { //Own cache line each, readers on different slots don't contend
+		std::atomic<const std::unordered_map<std::string, Variant>*> document = nullptr;
+	};
+
+	void Reclaim(); //Expects writerMutex locked
+
+	std::atomic<const std::unordered_map<std::string, Variant>*> current;
+	mutable HazardSlot hazards[JSON_SHARED_DOCUMENT_SLOTS];
+	mutable std::atomic<uint32_t> pinnedReaders = 0; //Snapshots without a hazard slot, nothing is reclaimed while there are any
+
+	std::mutex writerMutex; //Only taken by writers
+	std::vector<const std::unordered_map<std::string, Variant>*> retired;
+	std::vector<std::future<void>> reloads; //In flight ReloadAsync calls, joined by the destructor
+};
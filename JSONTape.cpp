@@ -0,0 +1,334 @@
+#include "JSON.hpp"
+
+#include <cstring>
+
+#define TAPE_WORD(tag, payload) (((uint64_t)(tag) << 56) | (uint64_t)(payload))
+
+
+JSON::Tape JSON::ParseTape(const std::string_view& string) {
+
+	Tape tape;
+	tape.words.reserve(string.size() / 8); //Rough guess, avoids most reallocations on number heavy documents
+
+	//Start word and element count of each open container
+	std::vector<std::pair<size_t, size_t>> open;
+
+	//Payloads have 56 bits, more than any tape that fits in memory can index, so neither the end index nor the count is ever truncated
+	auto closeContainer = [&]() {
+		const size_t start = open.back().first;
+		size_t count = open.back().second;
+		open.pop_back();
+
+		const bool isObject = tape.GetTag(start) == Tape::ObjectStart;
+		if (isObject)
+			count /= 2; //Keys were counted too
+
+		tape.words.push_back(TAPE_WORD(isObject ? Tape::ObjectEnd : Tape::ArrayEnd, count));
+		tape.words[start] = TAPE_WORD(isObject ? Tape::ObjectStart : Tape::ArrayStart, tape.words.size());
+	};
+
+	size_t index = 0;
+	while (true) {
+		std::string_view token;
+		GetToken(string, index, token);
+		if (token.empty())
+			break;
+
+		const uint8_t character = token[0];
+
+		if (character == ',' || character == ':')
+			continue;
+
+		if (character == '}' || character == ']') {
+			if (open.empty()) //Stray closing character
+				break;
+
+			closeContainer();
+
+			if (open.empty()) //Root value finished
+				break;
+
+			continue;
+		}
+
+		if (!open.empty())
+			++open.back().second;
+
+		if (character == '{' || character == '[') {
+			open.emplace_back(tape.words.size(), 0);
+			tape.words.push_back(TAPE_WORD(character, 0)); //Patched when closed
+			continue;
+		}
+
+		if (character == '"') {
+			tape.words.push_back(TAPE_WORD(Tape::StringTag, tape.strings.size()));
+
+			const size_t lengthOffset = tape.strings.size();
+			tape.strings.append(sizeof(uint64_t), '\0');
+			UnescapeString(token, tape.strings);
+
+			const uint64_t length = tape.strings.size() - lengthOffset - sizeof(uint64_t);
+			memcpy(&tape.strings[lengthOffset], &length, sizeof(uint64_t));
+			tape.strings.push_back('\0');
+		}
+		else if (character == 't') {
+			tape.words.push_back(TAPE_WORD(Tape::TrueTag, 0));
+		}
+		else if (character == 'f') {
+			tape.words.push_back(TAPE_WORD(Tape::FalseTag, 0));
+		}
+		else if (character == 'n') {
+			tape.words.push_back(TAPE_WORD(Tape::NullTag, 0));
+		}
+		else if (isdigit(character) || character == '-') {
+			int64_t integer;
+			double number;
+			if (ParseNumber(token, integer, number)) {
+				tape.words.push_back(TAPE_WORD(Tape::IntTag, 0));
+				tape.words.push_back((uint64_t)integer);
+			}
+			else {
+				uint64_t bits;
+				memcpy(&bits, &number, sizeof(double));
+				tape.words.push_back(TAPE_WORD(Tape::FloatTag, 0));
+				tape.words.push_back(bits);
+			}
+		}
+		else {
+			if (!open.empty()) //Unknown token, not a value
+				--open.back().second;
+
+			continue;
+		}
+
+		if (open.empty()) //Root value was a primitive
+			break;
+	}
+
+	//Close any container left open by a truncated document, so skipping stays in bounds
+	while (!open.empty())
+		closeContainer();
+
+	return tape;
+}
+
+
+size_t JSON::Tape::Skip(size_t index) const {
+
+	switch (GetTag(index)) {
+
+	case ObjectStart:
+	case ArrayStart:
+		return (size_t)GetPayload(index);
+
+	case IntTag:
+	case FloatTag:
+		return index + 2;
+
+	default:
+		return index + 1;
+	}
+}
+
+std::string_view JSON::Tape::GetString(size_t index) const {
+
+	const size_t offset = (size_t)GetPayload(index);
+
+	uint64_t length;
+	memcpy(&length, &strings[offset], sizeof(uint64_t));
+
+	return std::string_view(&strings[offset + sizeof(uint64_t)], (size_t)length);
+}
+
+
+Variant::Type JSON::Tape::Value::GetType() const {
+
+	if (tape == nullptr)
+		return Variant::Unknown;
+
+	switch (tape->GetTag(index)) {
+
+	case ObjectStart:
+		return Variant::Dictionary;
+
+	case ArrayStart:
+		return Variant::VariantArray;
+
+	case StringTag:
+		return Variant::String;
+
+	case IntTag:
+		return Variant::Int;
+
+	case FloatTag:
+		return Variant::Float;
+
+	case TrueTag:
+	case FalseTag:
+		return Variant::Bool;
+
+	case NullTag:
+		return Variant::Pointer;
+
+	default:
+		return Variant::Unknown;
+	}
+}
+
+bool JSON::Tape::Value::IsNull() const {
+	return tape != nullptr && tape->GetTag(index) == NullTag;
+}
+
+bool JSON::Tape::Value::GetBool() const {
+	return tape != nullptr && tape->GetTag(index) == TrueTag;
+}
+
+int64_t JSON::Tape::Value::GetInt() const { //Same conversions as Variant
+
+	if (tape == nullptr)
+		return 0;
+
+	if (tape->GetTag(index) == IntTag)
+		return (int64_t)tape->words[index + 1];
+
+	if (tape->GetTag(index) == FloatTag)
+		return (int64_t)std::round(GetFloat());
+
+	return 0;
+}
+
+double JSON::Tape::Value::GetFloat() const {
+
+	if (tape == nullptr)
+		return 0.0;
+
+	if (tape->GetTag(index) == FloatTag) {
+		double number;
+		memcpy(&number, &tape->words[index + 1], sizeof(double));
+		return number;
+	}
+
+	if (tape->GetTag(index) == IntTag)
+		return (double)(int64_t)tape->words[index + 1];
+
+	return 0.0;
+}
+
+std::string_view JSON::Tape::Value::GetString() const {
+
+	if (tape == nullptr || tape->GetTag(index) != StringTag)
+		return std::string_view();
+
+	return tape->GetString(index);
+}
+
+
+size_t JSON::Tape::Value::Size() const {
+
+	if (tape == nullptr)
+		return 0;
+
+	const Tag tag = tape->GetTag(index);
+	if (tag != ObjectStart && tag != ArrayStart)
+		return 0;
+
+	return (size_t)tape->GetPayload(tape->Skip(index) - 1); //Counted on the end word
+}
+
+JSON::Tape::Value JSON::Tape::Value::operator[](size_t elementIndex) const {
+
+	if (tape == nullptr || tape->GetTag(index) != ArrayStart)
+		return Value();
+
+	for (Iterator it = begin(); it != end(); ++it) {
+		if (elementIndex == 0)
+			return *it;
+
+		--elementIndex;
+	}
+
+	return Value();
+}
+
+JSON::Tape::Value JSON::Tape::Value::Find(const Key& key) const {
+
+	if (tape == nullptr || tape->GetTag(index) != ObjectStart)
+		return Value();
+
+	for (Iterator it = begin(); it != end(); ++it) {
+		if (it.GetKey() == key.GetName())
+			return *it;
+	}
+
+	return Value();
+}
+
+
+JSON::Tape::Value::Iterator JSON::Tape::Value::begin() const {
+
+	if (tape == nullptr)
+		return Iterator(nullptr, 0, false);
+
+	const Tag tag = tape->GetTag(index);
+	if (tag != ObjectStart && tag != ArrayStart)
+		return end();
+
+	return Iterator(tape, index + 1, tag == ObjectStart);
+}
+
+JSON::Tape::Value::Iterator JSON::Tape::Value::end() const {
+
+	if (tape == nullptr)
+		return Iterator(nullptr, 0, false);
+
+	const Tag tag = tape->GetTag(index);
+	if (tag != ObjectStart && tag != ArrayStart)
+		return Iterator(tape, index, false);
+
+	return Iterator(tape, tape->Skip(index) - 1, tag == ObjectStart); //The end word
+}
+
+
+Variant JSON::Tape::Value::ToVariant() const {
+
+	switch (GetType()) {
+
+	case Variant::Pointer:
+		return (void*)nullptr;
+
+	case Variant::Bool:
+		return GetBool();
+
+	case Variant::Int:
+		return GetInt();
+
+	case Variant::Float:
+		return GetFloat();
+
+	case Variant::String:
+		return std::string(GetString());
+
+	case Variant::VariantArray: {
+		Variant variant = std::vector<Variant>();
+		auto& vector = *(std::vector<Variant>*)variant.GetData();
+		vector.reserve(Size());
+		for (Iterator it = begin(); it != end(); ++it)
+			vector.push_back((*it).ToVariant());
+
+		return variant;
+	}
+
+	case Variant::Dictionary: {
+		Variant variant = std::unordered_map<std::string, Variant>();
+		auto& map = *(std::unordered_map<std::string, Variant>*)variant.GetData();
+		map.reserve(Size());
+		for (Iterator it = begin(); it != end(); ++it)
+			map[std::string(it.GetKey())] = (*it).ToVariant();
+
+		return variant;
+	}
+
+	default:
+		return Variant();
+	}
+}
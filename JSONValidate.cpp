@@ -0,0 +1,344 @@
+#include "JSON.hpp"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JSON_VALIDATE_SSE2
+#endif
+
+#ifndef JSON_VALIDATE_MAX_DEPTH
+#define JSON_VALIDATE_MAX_DEPTH 1024 //Nesting is tracked on a fixed stack buffer to avoid allocations
+#endif
+
+
+static inline bool IsDigit(const uint8_t character) { //Locale independent, unlike isdigit
+	return (uint8_t)(character - '0') < 10;
+}
+
+static inline bool IsWhitespace(const uint8_t character) { //Only RFC 8259 whitespace, unlike isspace
+	return character == ' ' || character == '\n' || character == '\r' || character == '\t';
+}
+
+#ifdef JSON_VALIDATE_SSE2
+static inline size_t FirstBit(const int mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long first;
+	_BitScanForward(&first, mask);
+	return first;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+
+static inline void SkipWhitespace(const uint8_t* data, size_t size, size_t& i) {
+
+	//Scalar, a vectorized skip measured no faster since whitespace runs between tokens are short
+	while (i < size && IsWhitespace(data[i]))
+		++i;
+}
+
+static inline bool ValidateLiteral(const uint8_t* data, size_t size, size_t& i, const char* literal, const size_t length) {
+
+	if (size - i < length || memcmp(&data[i], literal, length) != 0)
+		return false;
+
+	i += length;
+	return true;
+}
+
+static inline void SkipDigits(const uint8_t* data, size_t size, size_t& i) {
+
+	while (i < size && IsDigit(data[i]))
+		++i;
+}
+
+static inline bool ValidateNumber(const uint8_t* data, size_t size, size_t& i) {
+
+	if (i < size && data[i] == '-')
+		++i;
+
+	//Integer part, no leading zeros
+	if (i >= size || !IsDigit(data[i]))
+		return false;
+
+	if (data[i] == '0')
+		++i;
+	else
+		SkipDigits(data, size, i);
+
+	if (i < size && data[i] == '.') {
+		++i;
+		if (i >= size || !IsDigit(data[i]))
+			return false;
+
+		SkipDigits(data, size, i);
+	}
+
+	if (i < size && (data[i] == 'e' || data[i] == 'E')) {
+		++i;
+		if (i < size && (data[i] == '+' || data[i] == '-'))
+			++i;
+
+		if (i >= size || !IsDigit(data[i]))
+			return false;
+
+		SkipDigits(data, size, i);
+	}
+
+	return true;
+}
+
+static inline bool ValidateUTF8(const uint8_t* data, size_t size, size_t& i) {
+
+	//Well formed sequences as per Unicode Table 3-7, rejecting overlongs, surrogates and code points past U+10FFFF
+	const uint8_t lead = data[i];
+	size_t continuations;
+	uint8_t secondMin = 0x80;
+	uint8_t secondMax = 0xBF;
+
+	if (lead >= 0xC2 && lead <= 0xDF) {
+		continuations = 1;
+	}
+	else if (lead >= 0xE0 && lead <= 0xEF) {
+		continuations = 2;
+		if (lead == 0xE0)
+			secondMin = 0xA0;
+		else if (lead == 0xED)
+			secondMax = 0x9F;
+	}
+	else if (lead >= 0xF0 && lead <= 0xF4) {
+		continuations = 3;
+		if (lead == 0xF0)
+			secondMin = 0x90;
+		else if (lead == 0xF4)
+			secondMax = 0x8F;
+	}
+	else {
+		return false;
+	}
+
+	if (size - i <= continuations)
+		return false;
+
+	if (data[i + 1] < secondMin || data[i + 1] > secondMax)
+		return false;
+
+	for (size_t j = 2; j <= continuations; ++j) {
+		if ((data[i + j] & 0xC0) != 0x80)
+			return false;
+	}
+
+	i += continuations + 1;
+	return true;
+}
+
+static inline bool ValidateString(const uint8_t* data, size_t size, size_t& i) {
+
+	++i; //Skip opening quote
+
+	while (true) {
+#ifdef JSON_VALIDATE_SSE2
+		//Skip plain ASCII 16 bytes at a time, stopping on quotes, escapes, control characters and non ASCII bytes (Signed compare catches both < 0x20 and >= 0x80)
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i backslash = _mm_set1_epi8('\\');
+		const __m128i control = _mm_set1_epi8(0x20);
+		while (i + 16 <= size) {
+			const __m128i chunk = _mm_loadu_si128((const __m128i*)&data[i]);
+			const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)), _mm_cmplt_epi8(chunk, control));
+			const int mask = _mm_movemask_epi8(special);
+			if (mask != 0) {
+				i += FirstBit(mask);
+				break;
+			}
+
+			i += 16;
+		}
+#endif
+
+		if (i >= size)
+			return false;
+
+		const uint8_t character = data[i];
+
+		if (character == '"') {
+			++i;
+			return true;
+		}
+
+		if (character == '\\') {
+			++i;
+			if (i >= size)
+				return false;
+
+			switch (data[i]) {
+
+			case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+				++i;
+				break;
+
+			case 'u': {
+				++i;
+				for (size_t j = 0; j < 4; ++j, ++i) {
+					if (i >= size || !isxdigit(data[i]))
+						return false;
+				}
+				break;
+			}
+
+			default:
+				return false;
+			}
+
+			continue;
+		}
+
+		if (character < 0x20)
+			return false;
+
+		if (character < 0x80) {
+			++i;
+			continue;
+		}
+
+		if (!ValidateUTF8(data, size, i))
+			return false;
+	}
+}
+
+static inline bool ValidateKey(const uint8_t* data, size_t size, size_t& i) {
+
+	SkipWhitespace(data, size, i);
+	if (i >= size || data[i] != '"' || !ValidateString(data, size, i))
+		return false;
+
+	SkipWhitespace(data, size, i);
+	if (i >= size || data[i] != ':')
+		return false;
+
+	++i;
+	return true;
+}
+
+
+bool JSON::Validate(const std::string_view& string) {
+	size_t errorOffset;
+	return Validate(string, errorOffset);
+}
+
+bool JSON::Validate(const std::string_view& string, size_t& errorOffset) {
+
+	const uint8_t* data = (const uint8_t*)string.data();
+	const size_t size = string.size();
+
+	uint8_t stack[JSON_VALIDATE_MAX_DEPTH]; //Open container characters
+	size_t depth = 0;
+	size_t i = 0;
+
+	while (true) {
+		//Value expected
+		SkipWhitespace(data, size, i);
+		if (i >= size) {
+			errorOffset = i;
+			return false;
+		}
+
+		const uint8_t character = data[i];
+		bool valid;
+		switch (character) {
+
+		case '{':
+		case '[': {
+			++i;
+			SkipWhitespace(data, size, i);
+			if (i < size && data[i] == (character == '{' ? '}' : ']')) { //Empty container
+				++i;
+				valid = true;
+				break;
+			}
+
+			if (depth == JSON_VALIDATE_MAX_DEPTH) {
+				errorOffset = i;
+				return false;
+			}
+
+			stack[depth++] = character;
+
+			if (character == '{' && !ValidateKey(data, size, i)) {
+				errorOffset = i;
+				return false;
+			}
+
+			continue;
+		}
+
+		case '"':
+			valid = ValidateString(data, size, i);
+			break;
+
+		case 't':
+			valid = ValidateLiteral(data, size, i, "true", 4);
+			break;
+
+		case 'f':
+			valid = ValidateLiteral(data, size, i, "false", 5);
+			break;
+
+		case 'n':
+			valid = ValidateLiteral(data, size, i, "null", 4);
+			break;
+
+		default:
+			valid = ValidateNumber(data, size, i);
+			break;
+		}
+
+		if (!valid) {
+			errorOffset = i;
+			return false;
+		}
+
+		//Value ended, close as many containers as possible until a separator is found
+		while (true) {
+			SkipWhitespace(data, size, i);
+
+			if (depth == 0) {
+				if (i != size) { //Trailing data
+					errorOffset = i;
+					return false;
+				}
+
+				return true;
+			}
+
+			if (i >= size) {
+				errorOffset = i;
+				return false;
+			}
+
+			const uint8_t next = data[i];
+			const uint8_t open = stack[depth - 1];
+
+			if (next == ',') {
+				++i;
+				if (open == '{' && !ValidateKey(data, size, i)) {
+					errorOffset = i;
+					return false;
+				}
+
+				break;
+			}
+
+			if ((next == '}' && open == '{') || (next == ']' && open == '[')) {
+				++i;
+				--depth;
+				continue;
+			}
+
+			errorOffset = i;
+			return false;
+		}
+	}
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cmath>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -42,7 +43,7 @@ public:
 	}
 
 
-	Variant(Variant&& other) {
+	Variant(Variant&& other) noexcept { //noexcept so std::vector moves instead of deep copying on reallocation
 		//Move data and adquire ownership of it
 		ptr = other.ptr;
 		type = other.type;
@@ -50,7 +51,7 @@ public:
 		other.ownership = false;
 	}
 
-	Variant& operator=(Variant&& other) {
+	Variant& operator=(Variant&& other) noexcept {
 		//Free original data, if any
 		if (OwnsData())
 			FreeHeapData();
@@ -77,7 +78,7 @@ public:
 	}
 
 	Variant(bool pData) {
-		*(bool*)&ptr = pData;
+		ptr = (void*)(uintptr_t)pData; //Whole word, operator bool reads all of it
 		type = Bool;
 		ownership = false;
 	}
@@ -220,7 +221,7 @@ public:
 
 	operator double() const {
 		if (type == Int) //Must be casted first for correct conversion
-			return *(double*)(int64_t*)&ptr;
+			return (double)*(int64_t*)&ptr;
 		if (type == Float)
 			return *(double*)&ptr;
 
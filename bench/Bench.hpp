@@ -0,0 +1,72 @@
+//Helpers shared by the microbenchmarks, each Bench*.cpp is a standalone program built from the repository root with:
+//g++ -std=c++17 -O2 -I. bench/BenchNumbers.cpp *.cpp -lpthread -o BenchNumbers
+//Numbers are the best of several runs
+
+#pragma once
+
+#include "JSON.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+
+template <typename Function>
+static double Measure(Function function, int runs = 5) { //Seconds, best run
+
+	double best = 1e30;
+	for (int i = 0; i < runs; ++i) {
+		const auto start = std::chrono::steady_clock::now();
+		function();
+		const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		best = std::min(best, elapsed);
+	}
+
+	return best;
+}
+
+static inline void PrintThroughput(const char* name, size_t bytes, double seconds) {
+	printf("  %-40s %8.1f MB/s\n", name, bytes / seconds / 1e6);
+}
+
+static inline void WriteFile(const std::string& path, const std::string& contents) {
+	std::ofstream file(path, std::ios::binary);
+	file.write(contents.data(), contents.size());
+}
+
+static inline std::string ReadFile(const std::string& path) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	std::string contents((size_t)file.tellg(), '\0');
+	file.seekg(0);
+	file.read(&contents[0], contents.size());
+	return contents;
+}
+
+static inline std::string MakeEvents(size_t count, size_t fields) { //{"events":[...]} of flat records mixing integers, floats and strings
+
+	std::string events = "{\"events\":[";
+	for (size_t i = 0; i < count; ++i) {
+		if (i > 0)
+			events += ',';
+
+		events += '{';
+		for (size_t j = 0; j < fields; ++j) {
+			if (j > 0)
+				events += ',';
+
+			events += "\"field" + std::to_string(j) + "\":";
+			if (j % 3 == 0)
+				events += std::to_string(i * j);
+			else if (j % 3 == 1)
+				events += std::to_string(i * 0.25 + j);
+			else
+				events += "\"value " + std::to_string(i) + "\"";
+		}
+
+		events += '}';
+	}
+
+	events += "]}";
+	return events;
+}
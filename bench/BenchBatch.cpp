@@ -0,0 +1,46 @@
+//FileLoader::LoadAsync against a sequential read and parse loop over the same files
+
+#include "Bench.hpp"
+#include "JSONAsync.hpp"
+
+#include <thread>
+
+
+int main() {
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "NeonJSONBench";
+	std::filesystem::create_directories(directory);
+
+	printf("Batch loading (200 files of 100 events, %u hardware threads)\n", std::thread::hardware_concurrency());
+
+	std::vector<std::string> paths;
+	size_t bytes = 0;
+	for (size_t i = 0; i < 200; ++i) {
+		const std::string events = MakeEvents(100, 20 + i % 10);
+		paths.push_back((directory / ("file" + std::to_string(i) + ".json")).string());
+		WriteFile(paths.back(), events);
+		bytes += events.size();
+	}
+
+	PrintThroughput("Sequential read then ParseJSON", bytes, Measure([&]() {
+		for (const std::string& path : paths)
+			JSON::ParseJSON(ReadFile(path));
+	}));
+
+	PrintThroughput("LoadAsync, futures", bytes, Measure([&]() {
+		for (auto& future : JSON::FileLoader::LoadAsync(paths))
+			future.get();
+	}));
+
+	PrintThroughput("LoadAsync, callback", bytes, Measure([&]() {
+		JSON::FileLoader::LoadAsync(paths, [](JSON::FileLoader::Result&) {}).get();
+	}));
+
+	PrintThroughput("LoadAsync, 1 I/O and 1 parse thread", bytes, Measure([&]() {
+		JSON::FileLoader::LoadAsync(paths, [](JSON::FileLoader::Result&) {}, 64 * 1024 * 1024, 1, 1).get();
+	}));
+
+	std::filesystem::remove_all(directory);
+
+	return 0;
+}
@@ -0,0 +1,81 @@
+//Pipelined ParseCompressedFile against decompressing to a string first, add -DJSON_GZIP_EXTENSION -lz and -DJSON_ZSTD_EXTENSION -lzstd to compare compressed files
+
+#include "Bench.hpp"
+
+#ifdef JSON_GZIP_EXTENSION
+#include <zlib.h>
+#endif
+
+#ifdef JSON_ZSTD_EXTENSION
+#include <zstd.h>
+#endif
+
+
+int main() {
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "NeonJSONBench";
+	std::filesystem::create_directories(directory);
+
+	printf("Compressed files (50k events of 20 fields)\n");
+
+	const std::string events = MakeEvents(50000, 20);
+	const std::string plainPath = (directory / "events.json").string();
+	WriteFile(plainPath, events);
+
+	std::unordered_map<std::string, Variant> map;
+	PrintThroughput("Read then ParseJSON", events.size(), Measure([&]() { JSON::ParseJSON(ReadFile(plainPath)); }));
+	PrintThroughput("ParseCompressedFile, plain text", events.size(), Measure([&]() { JSON::ParseCompressedFile(plainPath, map); }));
+
+#ifdef JSON_GZIP_EXTENSION
+	std::string gzipped(compressBound((uLong)events.size()) + 32, '\0');
+	z_stream stream = {};
+	deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY); //+16: gzip header
+	stream.next_in = (Bytef*)events.data();
+	stream.avail_in = (uInt)events.size();
+	stream.next_out = (Bytef*)&gzipped[0];
+	stream.avail_out = (uInt)gzipped.size();
+	deflate(&stream, Z_FINISH);
+	gzipped.resize(stream.total_out);
+	deflateEnd(&stream);
+
+	const std::string gzipPath = (directory / "events.json.gz").string();
+	WriteFile(gzipPath, gzipped);
+
+	PrintThroughput("Gunzip to a string then ParseJSON", events.size(), Measure([&]() {
+		const std::string input = ReadFile(gzipPath);
+		std::string output(events.size(), '\0'); //Size known upfront, the best case for the two pass approach
+		z_stream inflateStream = {};
+		inflateInit2(&inflateStream, 15 + 32);
+		inflateStream.next_in = (Bytef*)input.data();
+		inflateStream.avail_in = (uInt)input.size();
+		inflateStream.next_out = (Bytef*)&output[0];
+		inflateStream.avail_out = (uInt)output.size();
+		inflate(&inflateStream, Z_FINISH);
+		inflateEnd(&inflateStream);
+		JSON::ParseJSON(output);
+	}));
+
+	PrintThroughput("ParseCompressedFile, gzip", events.size(), Measure([&]() { JSON::ParseCompressedFile(gzipPath, map); }));
+#endif
+
+#ifdef JSON_ZSTD_EXTENSION
+	std::string zstdCompressed(ZSTD_compressBound(events.size()), '\0');
+	zstdCompressed.resize(ZSTD_compress(&zstdCompressed[0], zstdCompressed.size(), events.data(), events.size(), 3));
+
+	const std::string zstdPath = (directory / "events.json.zst").string();
+	WriteFile(zstdPath, zstdCompressed);
+
+	PrintThroughput("Unzstd to a string then ParseJSON", events.size(), Measure([&]() {
+		const std::string input = ReadFile(zstdPath);
+		std::string output(events.size(), '\0');
+		ZSTD_decompress(&output[0], output.size(), input.data(), input.size());
+		JSON::ParseJSON(output);
+	}));
+
+	PrintThroughput("ParseCompressedFile, zstd", events.size(), Measure([&]() { JSON::ParseCompressedFile(zstdPath, map); }));
+#endif
+
+	std::filesystem::remove_all(directory);
+
+	return 0;
+}
@@ -0,0 +1,51 @@
+//Sidecar size and lookups through JSON::IndexedFile against parsing the whole file
+
+#include "Bench.hpp"
+
+
+int main() {
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "NeonJSONBench";
+	std::filesystem::create_directories(directory);
+
+	for (const size_t count : { 100000, 1000000 }) {
+		printf("Indexed file (%zu records of {\"a\":i,\"b\":j})\n", count);
+
+		std::string records = "[";
+		for (size_t i = 0; i < count; ++i) {
+			if (i > 0)
+				records += ',';
+
+			records += "{\"a\":" + std::to_string(i) + ",\"b\":" + std::to_string(i * 7) + "}";
+		}
+
+		records += "]";
+
+		const std::string path = (directory / "records.json").string();
+		WriteFile(path, records);
+
+		PrintThroughput("BuildIndex", records.size(), Measure([&]() { JSON::BuildIndex(path); }, 3));
+		printf("  %-40s %8zu bytes, %zu in the sidecar\n", "File size", records.size(), (size_t)std::filesystem::file_size(path + ".idx"));
+
+		const double parse = Measure([&]() { JSON::ParseJSON("{\"records\":" + ReadFile(path) + "}"); }, 3); //Wrapped since ParseJSON only returns maps
+		printf("  %-40s %8.1f us\n", "Read and ParseJSON the whole file", parse * 1e6);
+
+		const double open = Measure([&]() { JSON::IndexedFile indexed(path); });
+		printf("  %-40s %8.1f us\n", "Open the IndexedFile", open * 1e6);
+
+		JSON::IndexedFile indexed(path);
+		const size_t lookups = 10000;
+		size_t found = 0;
+		const double get = Measure([&]() {
+			Variant value;
+			for (size_t i = 0; i < lookups; ++i)
+				found += indexed.Get("/" + std::to_string(i * 7919 % count) + "/b", value);
+		});
+
+		printf("  %-40s %8.1f us (%zu)\n", "Get of a random record", get / lookups * 1e6, found);
+	}
+
+	std::filesystem::remove_all(directory);
+
+	return 0;
+}
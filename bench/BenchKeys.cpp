@@ -0,0 +1,41 @@
+//JSON::Key lookups against operator[] with string literals
+
+#include "Bench.hpp"
+
+
+int main() {
+
+	printf("Dictionary lookups (3 keys per node, 1M nodes)\n");
+
+	std::unordered_map<std::string, Variant> node = JSON::ParseJSON("{\"name\":\"node\",\"mesh\":3,\"translation\":[0,1,2],\"rotation\":[0,0,0,1],\"scale\":[1,1,1],\"children\":[1,2]}");
+	const size_t iterations = 1000000;
+
+	static constexpr JSON::Key translation = "translation";
+	static constexpr JSON::Key rotation = "rotation";
+	static constexpr JSON::Key scale = "scale";
+
+	size_t found = 0;
+	const double literal = Measure([&]() {
+		for (size_t i = 0; i < iterations; ++i)
+			found += node["translation"].GetType() + node["rotation"].GetType() + node["scale"].GetType();
+	});
+
+	const double find = Measure([&]() {
+		for (size_t i = 0; i < iterations; ++i)
+			found += (JSON::Find(node, translation) != nullptr) + (JSON::Find(node, rotation) != nullptr) + (JSON::Find(node, scale) != nullptr);
+	});
+
+	const double get = Measure([&]() {
+		for (size_t i = 0; i < iterations; ++i) {
+			auto [t, r, s] = JSON::Get(node, translation, rotation, scale);
+			found += (t != nullptr) + (r != nullptr) + (s != nullptr);
+		}
+	});
+
+	printf("  %-40s %8.1f ns\n", "operator[] with literals", literal / iterations * 1e9);
+	printf("  %-40s %8.1f ns\n", "JSON::Find", find / iterations * 1e9);
+	printf("  %-40s %8.1f ns\n", "JSON::Get", get / iterations * 1e9);
+	printf("  (%zu)\n", found);
+
+	return 0;
+}
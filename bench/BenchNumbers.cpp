@@ -0,0 +1,29 @@
+//Number parsing on float and integer heavy documents
+
+#include "Bench.hpp"
+
+
+int main() {
+
+	printf("Number parsing (1M values)\n");
+
+	std::string floats = "{\"positions\":[";
+	std::string integers = "{\"indices\":[";
+	for (size_t i = 0; i < 1000000; ++i) {
+		if (i > 0) {
+			floats += ',';
+			integers += ',';
+		}
+
+		floats += std::to_string((double)(i * 7919 % 100003) / 37.0 - 1000.0);
+		integers += std::to_string(i * 7919 % 100003);
+	}
+
+	floats += "]}";
+	integers += "]}";
+
+	PrintThroughput("ParseJSON floats", floats.size(), Measure([&]() { JSON::ParseJSON(floats); }));
+	PrintThroughput("ParseJSON integers", integers.size(), Measure([&]() { JSON::ParseJSON(integers); }));
+
+	return 0;
+}
@@ -0,0 +1,27 @@
+//Projected parsing against a full parse, keeping a growing share of the fields of every record
+
+#include "Bench.hpp"
+
+
+int main() {
+
+	printf("Projection (5k events of 200 fields)\n");
+
+	const std::string events = MakeEvents(5000, 200);
+	PrintThroughput("Full parse", events.size(), Measure([&]() { JSON::ParseJSON(events); }));
+
+	for (const size_t selected : { 1, 5, 50, 200 }) {
+		std::vector<std::string> paths;
+		for (size_t j = 0; j < selected; ++j)
+			paths.push_back("/events/*/field" + std::to_string(j * 200 / selected));
+
+		const JSON::Projection projection(paths);
+		const std::string name = "Projection of " + std::to_string(selected) + " fields";
+		PrintThroughput(name.data(), events.size(), Measure([&]() { JSON::ParseJSON(events, projection); }));
+	}
+
+	const JSON::Projection indexed({ "/events/0/field0", "/events/4999/field0" });
+	PrintThroughput("Projection of 2 records by index", events.size(), Measure([&]() { JSON::ParseJSON(events, indexed); }));
+
+	return 0;
+}
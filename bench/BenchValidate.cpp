@@ -0,0 +1,40 @@
+//JSON::Validate throughput against a full ParseJSON of the same input
+
+#include "Bench.hpp"
+
+
+int main() {
+
+	printf("Validation\n");
+
+	std::string floats = "{\"positions\":[";
+	for (size_t i = 0; i < 1000000; ++i) {
+		if (i > 0)
+			floats += ',';
+
+		floats += std::to_string((double)(i * 7919 % 100003) / 37.0 - 1000.0);
+	}
+
+	floats += "]}";
+
+	const std::string events = MakeEvents(20000, 20);
+	const std::string pretty = JSON::ToJSON(JSON::ParseJSON(events), true);
+
+	std::string strings = "{\"strings\":[";
+	for (size_t i = 0; i < 100000; ++i) {
+		if (i > 0)
+			strings += ',';
+
+		strings += "\"A longer string value number " + std::to_string(i) + " with some \\\"escapes\\\" and UTF-8 \xC3\xA9\xE2\x82\xAC\"";
+	}
+
+	strings += "]}";
+
+	const std::pair<const char*, const std::string*> inputs[] = { { "floats", &floats }, { "events", &events }, { "events pretty printed", &pretty }, { "strings", &strings } };
+	for (const auto& [name, input] : inputs) {
+		PrintThroughput((std::string("Validate ") + name).data(), input->size(), Measure([&]() { JSON::Validate(*input); }));
+		PrintThroughput((std::string("ParseJSON ") + name).data(), input->size(), Measure([&]() { JSON::ParseJSON(*input); }));
+	}
+
+	return 0;
+}
@@ -0,0 +1,24 @@
+#include "Tests.hpp"
+
+
+size_t testFailures = 0;
+
+std::vector<TestCase>& GetTestCases() {
+	static std::vector<TestCase> testCases;
+	return testCases;
+}
+
+
+int main() {
+
+	for (const TestCase& testCase : GetTestCases()) {
+		const size_t failures = testFailures;
+		testCase.function();
+		printf("%s %s\n", testFailures == failures ? "[ OK ]" : "[FAIL]", testCase.name);
+	}
+
+	std::filesystem::remove_all(std::filesystem::temp_directory_path() / "NeonJSONTests");
+
+	printf("%zu cases, %zu failed checks\n", GetTestCases().size(), testFailures);
+	return testFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include "Tests.hpp"
+#include "JSONAsync.hpp"
+
+#include <atomic>
+#include <thread>
+
+
+static std::vector<std::string> WriteBatch(const std::string& name, size_t count) { //Files holding {"index":i,...}
+
+	std::vector<std::string> paths;
+	for (size_t i = 0; i < count; ++i) {
+		paths.push_back(GetTestPath(name + std::to_string(i) + ".json"));
+		WriteTestFile(paths.back(), "{\"index\":" + std::to_string(i) + ",\"padding\":\"" + std::string(i * 37 % 5000, 'p') + "\"}");
+	}
+
+	return paths;
+}
+
+static bool HasIndex(const JSON::FileLoader::Result& result, int64_t index) {
+	const Variant* value = JSON::Find(result.map, "index");
+	return result.error.empty() && value != nullptr && (int64_t)*value == index;
+}
+
+
+TEST(AsyncFutures) {
+
+	std::vector<std::string> paths = WriteBatch("futures", 50);
+	paths.push_back(paths[3]); //Repeated paths get their own results
+
+	for (const uint32_t parseThreads : { 0u, 1u, 4u }) {
+		std::vector<std::future<JSON::FileLoader::Result>> futures = JSON::FileLoader::LoadAsync(paths, 64 * 1024 * 1024, 2, parseThreads);
+		CHECK(futures.size() == paths.size());
+
+		for (size_t i = 0; i < futures.size(); ++i) {
+			const JSON::FileLoader::Result result = futures[i].get();
+			CHECK(result.path == paths[i]);
+			CHECK(HasIndex(result, i < 50 ? (int64_t)i : 3));
+		}
+	}
+}
+
+TEST(AsyncErrors) {
+
+	std::vector<std::string> paths = WriteBatch("errors", 3);
+	paths.insert(paths.begin() + 1, GetTestPath("missing.json"));
+
+	const std::string directory = GetTestPath("directory");
+	std::filesystem::create_directories(directory);
+	paths.insert(paths.begin() + 2, directory); //Opens but can't be read, used to terminate the process
+
+	std::vector<std::future<JSON::FileLoader::Result>> futures = JSON::FileLoader::LoadAsync(paths);
+	CHECK(HasIndex(futures[0].get(), 0));
+
+	const JSON::FileLoader::Result missing = futures[1].get();
+	CHECK(missing.error == "Couldn't open file" && missing.map.empty());
+
+	const JSON::FileLoader::Result unreadable = futures[2].get();
+	CHECK(unreadable.error == "Couldn't read file" && unreadable.map.empty());
+
+	CHECK(HasIndex(futures[3].get(), 1));
+	CHECK(HasIndex(futures[4].get(), 2));
+}
+
+TEST(AsyncTinyBudget) {
+
+	//Files bigger than the budget still go through, one at a time
+	const std::vector<std::string> paths = WriteBatch("budget", 20);
+
+	std::vector<std::future<JSON::FileLoader::Result>> futures = JSON::FileLoader::LoadAsync(paths, 1, 3, 2);
+	for (size_t i = 0; i < futures.size(); ++i)
+		CHECK(HasIndex(futures[i].get(), i));
+}
+
+TEST(AsyncEmpty) {
+
+	CHECK(JSON::FileLoader::LoadAsync({}).empty());
+
+	std::future<void> done = JSON::FileLoader::LoadAsync({}, [](JSON::FileLoader::Result&) {});
+	CHECK(done.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+}
+
+TEST(AsyncCallbackThrows) {
+
+	const std::vector<std::string> paths = WriteBatch("throws", 20);
+
+	std::atomic<size_t> calls = 0;
+	std::future<void> done = JSON::FileLoader::LoadAsync(paths, [&](JSON::FileLoader::Result& result) {
+		++calls;
+		if (HasIndex(result, 5) || HasIndex(result, 6))
+			throw std::runtime_error("callback " + result.path);
+	});
+
+	bool rethrown = false;
+	try {
+		done.get();
+	}
+	catch (const std::runtime_error& exception) {
+		rethrown = std::string(exception.what()).find("callback") == 0;
+	}
+
+	CHECK(rethrown);
+	CHECK(calls == paths.size()); //The other files were still delivered
+}
+
+TEST(AsyncDroppedFuturesDontBlock) {
+
+	const std::vector<std::string> paths = WriteBatch("dropped", 10);
+
+	std::atomic<bool> release = false;
+	std::atomic<size_t> calls = 0;
+
+	//The callback can't finish until after the future is dropped, which would deadlock if dropping it waited
+	JSON::FileLoader::LoadAsync(paths, [&](JSON::FileLoader::Result&) {
+		while (!release)
+			std::this_thread::yield();
+
+		++calls;
+	});
+
+	{
+		std::vector<std::future<JSON::FileLoader::Result>> futures = JSON::FileLoader::LoadAsync(paths);
+	}
+
+	release = true;
+	for (int i = 0; i < 10000 && calls < paths.size(); ++i)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	CHECK(calls == paths.size());
+}
@@ -0,0 +1,202 @@
+#include "Tests.hpp"
+
+#ifdef JSON_GZIP_EXTENSION
+#include <zlib.h>
+#endif
+
+#ifdef JSON_ZSTD_EXTENSION
+#include <zstd.h>
+#endif
+
+
+static std::string MakeDocument(size_t members) { //Several ring chunks once decompressed for big counts
+
+	std::string document = "{";
+	for (size_t i = 0; i < members; ++i) {
+		if (i > 0)
+			document += ',';
+
+		document += "\"member" + std::to_string(i) + "\":{\"index\":" + std::to_string(i) + ",\"values\":[1.5,\"text " + std::to_string(i * 7919) + "\",null,true]}";
+	}
+
+	return document + "}";
+}
+
+static bool ParsesAs(const std::string& path, const std::string& document) {
+
+	std::unordered_map<std::string, Variant> map;
+	return JSON::ParseCompressedFile(path, map) && JSON::Diff(map, JSON::ParseJSON(document)).empty();
+}
+
+
+TEST(CompressedPlainText) {
+
+	const std::string path = GetTestPath("plain.json");
+
+	for (const size_t members : { 0, 1, 10000 }) {
+		const std::string document = MakeDocument(members);
+		WriteTestFile(path, document);
+		CHECK(ParsesAs(path, document));
+	}
+}
+
+TEST(CompressedUnreadable) {
+
+	std::unordered_map<std::string, Variant> map;
+	map["stale"] = Variant((int64_t)1);
+
+	CHECK(!JSON::ParseCompressedFile(GetTestPath("missing.json"), map));
+	CHECK(map.empty()); //Cleared even on failure
+
+	const std::string empty = GetTestPath("empty.json");
+	WriteTestFile(empty, "");
+	CHECK(!JSON::ParseCompressedFile(empty, map));
+
+	const std::string directory = GetTestPath("directory");
+	std::filesystem::create_directories(directory);
+	CHECK(!JSON::ParseCompressedFile(directory, map));
+}
+
+TEST(CompressedMalformedText) {
+
+	//Parsing stops on the unquoted key and cancels the decompressor, which still has more than the ring holds to produce
+	const std::string path = GetTestPath("malformed.json");
+	WriteTestFile(path, "{\"a\":1,b:" + std::string(8 * 1024 * 1024, ' ') + "1}");
+
+	std::unordered_map<std::string, Variant> map;
+	CHECK(JSON::ParseCompressedFile(path, map));
+	CHECK(map.size() == 1 && map.count("a") == 1);
+}
+
+#ifdef JSON_GZIP_EXTENSION
+static std::string Gzip(const std::string& text) {
+
+	std::string compressed(compressBound((uLong)text.size()) + 32, '\0');
+	z_stream stream = {};
+	deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY); //+16: gzip header
+	stream.next_in = (Bytef*)text.data();
+	stream.avail_in = (uInt)text.size();
+	stream.next_out = (Bytef*)&compressed[0];
+	stream.avail_out = (uInt)compressed.size();
+	deflate(&stream, Z_FINISH);
+	compressed.resize(stream.total_out);
+	deflateEnd(&stream);
+
+	return compressed;
+}
+
+TEST(CompressedGzip) {
+
+	const std::string path = GetTestPath("document.json.gz");
+
+	for (const size_t members : { 0, 1, 100, 20000 }) {
+		const std::string document = MakeDocument(members);
+		WriteTestFile(path, Gzip(document));
+		CHECK(ParsesAs(path, document));
+	}
+
+	//Concatenated members are one stream
+	const std::string document = MakeDocument(2000);
+	const size_t half = document.size() / 2;
+	WriteTestFile(path, Gzip(document.substr(0, half)) + Gzip(document.substr(half)));
+	CHECK(ParsesAs(path, document));
+}
+
+TEST(CompressedGzipCorrupt) {
+
+	const std::string path = GetTestPath("corrupt.json.gz");
+	const std::string compressed = Gzip(MakeDocument(20000));
+	std::unordered_map<std::string, Variant> map;
+
+	WriteTestFile(path, compressed.substr(0, compressed.size() / 2));
+	CHECK(!JSON::ParseCompressedFile(path, map));
+
+	WriteTestFile(path, compressed.substr(0, compressed.size() - 4)); //Only the trailer's length is missing
+	CHECK(!JSON::ParseCompressedFile(path, map));
+
+	std::string flipped = compressed;
+	for (size_t i = 20; i < 200; ++i)
+		flipped[i] = (char)~flipped[i];
+
+	WriteTestFile(path, flipped);
+	CHECK(!JSON::ParseCompressedFile(path, map));
+}
+#else
+TEST(CompressedGzipNotCompiledIn) {
+
+	const std::string path = GetTestPath("document.json.gz");
+	WriteTestFile(path, "\x1F\x8B\x08" + std::string(64, '\0')); //Gzip magic bytes
+
+	std::unordered_map<std::string, Variant> map;
+	CHECK(!JSON::ParseCompressedFile(path, map)); //Not mistaken for an empty document
+}
+#endif
+
+#ifdef JSON_ZSTD_EXTENSION
+static std::string Zstd(const std::string& text, bool checksum) {
+
+	std::string compressed(ZSTD_compressBound(text.size()), '\0');
+	if (!checksum) { //ZSTD_compress defaults, no content checksum
+		compressed.resize(ZSTD_compress(&compressed[0], compressed.size(), text.data(), text.size(), 3));
+		return compressed;
+	}
+
+	ZSTD_CCtx* context = ZSTD_createCCtx();
+	ZSTD_CCtx_setParameter(context, ZSTD_c_checksumFlag, 1);
+	compressed.resize(ZSTD_compress2(context, &compressed[0], compressed.size(), text.data(), text.size()));
+	ZSTD_freeCCtx(context);
+
+	return compressed;
+}
+
+TEST(CompressedZstd) {
+
+	const std::string path = GetTestPath("document.json.zst");
+
+	for (const bool checksum : { false, true }) {
+		for (const size_t members : { 0, 1, 100, 20000, 60000 }) {
+			const std::string document = MakeDocument(members);
+			WriteTestFile(path, Zstd(document, checksum));
+			CHECK(ParsesAs(path, document));
+		}
+	}
+
+	//Concatenated frames are one stream
+	const std::string document = MakeDocument(2000);
+	const size_t half = document.size() / 2;
+	WriteTestFile(path, Zstd(document.substr(0, half), false) + Zstd(document.substr(half), true));
+	CHECK(ParsesAs(path, document));
+}
+
+TEST(CompressedZstdCorrupt) {
+
+	const std::string path = GetTestPath("corrupt.json.zst");
+	std::unordered_map<std::string, Variant> map;
+
+	for (const bool checksum : { false, true }) {
+		const std::string compressed = Zstd(MakeDocument(20000), checksum);
+
+		WriteTestFile(path, compressed.substr(0, compressed.size() / 2));
+		CHECK(!JSON::ParseCompressedFile(path, map));
+
+		WriteTestFile(path, compressed.substr(0, compressed.size() - 1));
+		CHECK(!JSON::ParseCompressedFile(path, map));
+	}
+
+	std::string flipped = Zstd(MakeDocument(20000), true);
+	for (size_t i = 20; i < 200; ++i)
+		flipped[i] = (char)~flipped[i];
+
+	WriteTestFile(path, flipped);
+	CHECK(!JSON::ParseCompressedFile(path, map));
+}
+#else
+TEST(CompressedZstdNotCompiledIn) {
+
+	const std::string path = GetTestPath("document.json.zst");
+	WriteTestFile(path, "\x28\xB5\x2F\xFD" + std::string(64, '\0')); //Zstd magic bytes
+
+	std::unordered_map<std::string, Variant> map;
+	CHECK(!JSON::ParseCompressedFile(path, map));
+}
+#endif
@@ -0,0 +1,226 @@
+#include "Tests.hpp"
+
+
+static std::string MakeRecords(size_t count) { //The array of small records that the sidecar has to stay much smaller than
+
+	std::string records = "[";
+	for (size_t i = 0; i < count; ++i) {
+		if (i > 0)
+			records += ',';
+
+		records += "{\"a\":" + std::to_string(i) + ",\"b\":" + std::to_string(i * 7) + "}";
+	}
+
+	return records + "]";
+}
+
+static std::string MakeScene() { //Objects and arrays big enough to get tables, mixed with small ones
+
+	std::string scene = "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[";
+	for (size_t i = 0; i < 5000; ++i) {
+		if (i > 0)
+			scene += ",\n";
+
+		scene += "{\"name\":\"node" + std::to_string(i) + "\",\"mesh\":" + std::to_string(i % 17) + ",\"translation\":[" + std::to_string(i) + ",1.5,-2]}";
+	}
+
+	scene += "],\"big\":\"" + std::string(10000, 'x') + "\",\"meshes\":{";
+	for (size_t i = 0; i < 3000; ++i) {
+		if (i > 0)
+			scene += ',';
+
+		scene += "\"mesh" + std::to_string(i) + "\":{\"primitives\":[" + std::to_string(i) + "]}";
+	}
+
+	scene += "},\"a/b\":{\"c~d\":1},\"duplicate\":1,\"q\\\"k\":true,\"duplicate\":2,\"empty\":[],\"padded\":[" + std::string(5000, ' ') + "]}";
+	return scene;
+}
+
+static bool GetInt(JSON::IndexedFile& indexed, const std::string& pointer, int64_t expected) {
+	Variant value;
+	return indexed.Get(pointer, value) && value.GetType() == Variant::Int && (int64_t)value == expected;
+}
+
+static uint64_t FileSize(const std::string& path) {
+	return (uint64_t)std::filesystem::file_size(path);
+}
+
+
+TEST(IndexScene) {
+
+	const std::string path = GetTestPath("scene.json");
+	WriteTestFile(path, MakeScene());
+	CHECK(JSON::BuildIndex(path));
+
+	JSON::IndexedFile indexed(path);
+	CHECK(indexed.IsValid());
+
+	Variant value;
+	CHECK(indexed.Get("/asset/version", value) && std::string(value) == "2.0");
+	CHECK(GetInt(indexed, "/nodes/0/mesh", 0));
+	CHECK(GetInt(indexed, "/nodes/4321/mesh", 4321 % 17));
+	CHECK(GetInt(indexed, "/nodes/4999/translation/0", 4999)); //Deeper than maxDepth, resolved on the parsed element
+	CHECK(indexed.Get("/nodes/4999/translation/1", value) && (double)value == 1.5);
+	CHECK(GetInt(indexed, "/meshes/mesh0/primitives/0", 0));
+	CHECK(GetInt(indexed, "/meshes/mesh2999/primitives/0", 2999));
+	CHECK(indexed.Get("/big", value) && std::string(value).size() == 10000);
+	CHECK(GetInt(indexed, "/a~1b/c~0d", 1));
+	CHECK(indexed.Get("/q\"k", value) && value.GetType() == Variant::Bool);
+	CHECK(GetInt(indexed, "/duplicate", 2)); //Last one wins, like ParseJSON
+	CHECK(indexed.Get("/empty", value) && value.GetType() == Variant::VariantArray);
+	CHECK(indexed.Get("/padded", value) && value.GetType() == Variant::VariantArray);
+	CHECK(indexed.Get("/nodes/17", value) && value.GetType() == Variant::Dictionary);
+
+	CHECK(indexed.Get("", value) && value.GetType() == Variant::Dictionary); //Whole document
+	CHECK(((std::unordered_map<std::string, Variant>*)value.GetData())->size() == 9);
+}
+
+TEST(IndexMisses) {
+
+	const std::string path = GetTestPath("misses.json");
+	WriteTestFile(path, MakeScene());
+	CHECK(JSON::BuildIndex(path));
+
+	JSON::IndexedFile indexed(path);
+	Variant value;
+	CHECK(!indexed.Get("/missing", value));
+	CHECK(!indexed.Get("/meshes/mesh3000", value));
+	CHECK(!indexed.Get("/nodes/5000", value));
+	CHECK(!indexed.Get("/nodes/01", value)); //Leading zeros aren't indices
+	CHECK(!indexed.Get("/nodes/-", value));
+	CHECK(!indexed.Get("/nodes/18446744073709551616", value));
+	CHECK(!indexed.Get("/nodes/3/missing", value));
+	CHECK(!indexed.Get("/empty/0", value));
+	CHECK(!indexed.Get("/padded/0", value));
+	CHECK(!indexed.Get("/asset/version/0", value)); //Into a string
+	CHECK(!indexed.Get("nodes", value)); //Not a pointer
+}
+
+TEST(IndexSmallRecords) {
+
+	//100k records of {"a":i,"b":j}, the sidecar only holds sparse checkpoints
+	const std::string path = GetTestPath("records.json");
+	WriteTestFile(path, MakeRecords(100000));
+	CHECK(JSON::BuildIndex(path));
+	CHECK(FileSize(path + ".idx") * 50 < FileSize(path));
+
+	JSON::IndexedFile indexed(path);
+	for (const int64_t i : { 0, 1, 2, 999, 31337, 65535, 99998, 99999 }) {
+		CHECK(GetInt(indexed, "/" + std::to_string(i) + "/a", i));
+		CHECK(GetInt(indexed, "/" + std::to_string(i) + "/b", i * 7));
+	}
+
+	Variant value;
+	CHECK(!indexed.Get("/100000", value));
+}
+
+TEST(IndexDepths) {
+
+	const std::string path = GetTestPath("depths.json");
+	WriteTestFile(path, MakeScene());
+
+	for (const uint32_t maxDepth : { 0u, 1u, 3u }) {
+		CHECK(JSON::BuildIndex(path, maxDepth));
+
+		JSON::IndexedFile indexed(path);
+		CHECK(GetInt(indexed, "/nodes/4321/mesh", 4321 % 17));
+		CHECK(GetInt(indexed, "/meshes/mesh1234/primitives/0", 1234));
+
+		Variant value;
+		CHECK(!indexed.Get("/meshes/mesh3000", value));
+	}
+}
+
+TEST(IndexScalarRoot) {
+
+	const std::string path = GetTestPath("scalar.json");
+	WriteTestFile(path, " 42 ");
+	CHECK(JSON::BuildIndex(path));
+
+	JSON::IndexedFile indexed(path);
+	CHECK(GetInt(indexed, "", 42));
+
+	const std::string empty = GetTestPath("empty.json");
+	WriteTestFile(empty, "");
+	CHECK(!JSON::BuildIndex(empty));
+	CHECK(!JSON::IndexedFile(empty).IsValid());
+}
+
+TEST(IndexStale) {
+
+	const std::string path = GetTestPath("stale.json");
+	const std::string scene = MakeScene();
+	WriteTestFile(path, scene);
+	CHECK(JSON::BuildIndex(path));
+	CHECK(JSON::IndexedFile(path).IsValid());
+
+	//Same size, different content and modification time
+	std::string changed = scene;
+	changed[changed.size() - 2] = ' ';
+	WriteTestFile(path, changed);
+	std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+	CHECK(!JSON::IndexedFile(path).IsValid());
+
+	WriteTestFile(path, scene + " ");
+	CHECK(!JSON::IndexedFile(path).IsValid());
+
+	CHECK(!JSON::IndexedFile(GetTestPath("never-indexed.json")).IsValid());
+}
+
+TEST(IndexDamagedSidecar) {
+
+	const std::string path = GetTestPath("damaged.json");
+	WriteTestFile(path, MakeScene());
+	CHECK(JSON::BuildIndex(path));
+
+	std::string sidecar;
+	{
+		std::ifstream file(path + ".idx", std::ios::binary);
+		sidecar.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	const std::vector<std::string> pointers = { "", "/nodes/4321/mesh", "/meshes/mesh1234/primitives/0", "/missing", "/big" };
+
+	//Truncated at every few bytes, and with runs overwritten by 0xFF which makes counts and offsets huge: either fails or reads in bounds, never allocates from the bad values
+	for (size_t size = 0; size < sidecar.size(); size += 1 + size / 8) {
+		WriteTestFile(path + ".idx", sidecar.substr(0, size));
+
+		JSON::IndexedFile indexed(path);
+		Variant value;
+		for (const std::string& pointer : pointers)
+			indexed.Get(pointer, value);
+	}
+
+	for (size_t offset = 48; offset < sidecar.size(); offset += 1 + offset / 16) {
+		std::string damaged = sidecar;
+		for (size_t i = offset; i < std::min(offset + 8, damaged.size()); ++i)
+			damaged[i] = (char)0xFF;
+
+		WriteTestFile(path + ".idx", damaged);
+
+		JSON::IndexedFile indexed(path);
+		CHECK(indexed.IsValid()); //The header is intact
+		Variant value;
+		for (const std::string& pointer : pointers)
+			indexed.Get(pointer, value);
+	}
+
+	std::string wrongVersion = sidecar;
+	wrongVersion[4] = 9;
+	WriteTestFile(path + ".idx", wrongVersion);
+	CHECK(!JSON::IndexedFile(path).IsValid());
+}
+
+TEST(IndexMoved) {
+
+	const std::string path = GetTestPath("moved.json");
+	WriteTestFile(path, MakeRecords(1000));
+	CHECK(JSON::BuildIndex(path));
+
+	JSON::IndexedFile indexed(path);
+	JSON::IndexedFile moved = std::move(indexed);
+
+	Variant value;
+	CHECK(!indexed.IsValid() && !indexed.Get("/0/a", value));
+	CHECK(GetInt(moved, "/999/b", 999 * 7));
+}
@@ -0,0 +1,62 @@
+#include "Tests.hpp"
+
+
+TEST(KeyFromLiteral) {
+
+	static constexpr JSON::Key key = "translation";
+	static_assert(key.GetName().size() == 11, "The terminator isn't part of the name");
+
+	CHECK(key == JSON::Key(std::string_view("translation")));
+	CHECK(!(key == JSON::Key("rotation")));
+}
+
+TEST(KeyFind) {
+
+	std::unordered_map<std::string, Variant> map = JSON::ParseJSON("{\"mesh\":3,\"name\":\"node\",\"children\":{\"a\":1}}");
+
+	const Variant* mesh = JSON::Find(map, "mesh");
+	CHECK(mesh != nullptr && mesh->GetType() == Variant::Int && (int64_t)*mesh == 3);
+	CHECK(JSON::Find(map, "missing") == nullptr);
+	CHECK(JSON::Find(map, "mes") == nullptr); //Prefix of an existing key
+
+	Variant* name = JSON::Find(map, "name"); //Mutable overload
+	CHECK(name != nullptr && name->GetType() == Variant::String);
+
+	const Variant* children = JSON::Find(map, "children");
+	CHECK(children != nullptr && JSON::Find(*children, "a") != nullptr);
+	CHECK(JSON::Find(*mesh, "a") == nullptr); //Not a dictionary
+}
+
+TEST(KeyEmbeddedNul) {
+
+	std::unordered_map<std::string, Variant> map;
+	map[std::string("a\0b", 3)] = Variant((int64_t)1);
+	map["a"] = Variant((int64_t)2);
+
+	const Variant* value = JSON::Find(map, JSON::Key(std::string_view("a\0b", 3)));
+	CHECK(value != nullptr && (int64_t)*value == 1);
+}
+
+TEST(KeyGetSmallDictionary) {
+
+	std::unordered_map<std::string, Variant> map = JSON::ParseJSON("{\"translation\":[0,1,2],\"rotation\":[0,0,0,1],\"scale\":[1,1,1]}");
+
+	auto [translation, missing, scale, again] = JSON::Get(map, "translation", "weights", "scale", "translation");
+	CHECK(translation != nullptr && translation == JSON::Find(map, "translation"));
+	CHECK(missing == nullptr);
+	CHECK(scale != nullptr && scale == JSON::Find(map, "scale"));
+	CHECK(again == translation); //Repeated keys resolve to the same value
+}
+
+TEST(KeyGetBigDictionary) {
+
+	//More than 4 entries per key takes the hashed path
+	std::unordered_map<std::string, Variant> map;
+	for (int64_t i = 0; i < 100; ++i)
+		map["key" + std::to_string(i)] = Variant(i);
+
+	auto [first, last, missing] = JSON::Get(map, "key0", "key99", "key100");
+	CHECK(first != nullptr && (int64_t)*first == 0);
+	CHECK(last != nullptr && (int64_t)*last == 99);
+	CHECK(missing == nullptr);
+}
@@ -0,0 +1,116 @@
+#include "Tests.hpp"
+
+#include <cfloat>
+#include <cstring>
+#include <random>
+
+
+static Variant ParseScalar(const std::string& number) {
+	return JSON::ParseJSON("{\"v\":" + number + "}")["v"];
+}
+
+static bool IsInt(const std::string& number, int64_t expected) {
+	const Variant variant = ParseScalar(number);
+	return variant.GetType() == Variant::Int && (int64_t)variant == expected;
+}
+
+static bool IsFloat(const std::string& number, double expected) { //Bitwise, so -0.0 and 0.0 differ
+	const Variant variant = ParseScalar(number);
+	const double value = (double)variant;
+	return variant.GetType() == Variant::Float && memcmp(&value, &expected, sizeof(double)) == 0;
+}
+
+
+TEST(NumbersIntegers) {
+
+	CHECK(IsInt("0", 0));
+	CHECK(IsInt("-0", 0));
+	CHECK(IsInt("42", 42));
+	CHECK(IsInt("-42", -42));
+	CHECK(IsInt("12345678", 12345678)); //Exactly one SWAR step
+	CHECK(IsInt("1234567890123456789", 1234567890123456789));
+	CHECK(IsInt("9223372036854775807", INT64_MAX));
+	CHECK(IsInt("-9223372036854775808", INT64_MIN));
+}
+
+TEST(NumbersOverflowingIntegers) {
+
+	//Past int64_t they become doubles instead of wrapping
+	CHECK(IsFloat("9223372036854775808", 9223372036854775808.0));
+	CHECK(IsFloat("-9223372036854775809", -9223372036854775809.0));
+	CHECK(IsFloat("18446744073709551616", 18446744073709551616.0)); //Would wrap a uint64_t to 0
+	CHECK(IsFloat("123456789012345678901234567890", 123456789012345678901234567890.0));
+	CHECK(IsFloat("1" + std::string(400, '0'), HUGE_VAL));
+	CHECK(IsFloat("-1" + std::string(400, '0'), -HUGE_VAL));
+}
+
+TEST(NumbersFloats) {
+
+	CHECK(IsFloat("0.5", 0.5));
+	CHECK(IsFloat("-0.0", -0.0));
+	CHECK(IsFloat("1e5", 1e5));
+	CHECK(IsFloat("1E5", 1e5));
+	CHECK(IsFloat("1e+5", 1e5));
+	CHECK(IsFloat("1.5E-3", 1.5e-3));
+	CHECK(IsFloat("0.1", 0.1));
+	CHECK(IsFloat("3.141592653589793", 3.141592653589793));
+	CHECK(IsFloat("9007199254740993.0", 9007199254740992.0)); //Past 2^53, rounded to even by the exact path
+	CHECK(IsFloat("1.7976931348623157e308", DBL_MAX));
+	CHECK(IsFloat("4.9406564584124654e-324", 4.9406564584124654e-324)); //Smallest subnormal
+	CHECK(IsFloat("2.2250738585072014e-308", DBL_MIN));
+}
+
+TEST(NumbersSaturation) {
+
+	//Out of range values saturate by decimal magnitude
+	CHECK(IsFloat("1e400", HUGE_VAL));
+	CHECK(IsFloat("-1e400", -HUGE_VAL));
+	CHECK(IsFloat("1e-400", 0.0));
+	CHECK(IsFloat("-1e-400", -0.0));
+	CHECK(IsFloat("0." + std::string(400, '0') + "1", 0.0));
+	CHECK(IsFloat("0.001e400", HUGE_VAL));
+	CHECK(IsFloat("1000e-400", 0.0));
+	CHECK(IsFloat("1e99999999999", HUGE_VAL)); //Exponent clamped while parsing
+	CHECK(IsFloat("0e99999", 0.0));
+}
+
+TEST(NumbersRoundTrip) {
+
+	//Random finite doubles printed with 17 significant digits must come back bit exact, same as strtod
+	std::mt19937_64 random(1234);
+	char buffer[64];
+	size_t mismatches = 0;
+
+	for (size_t i = 0; i < 100000; ++i) {
+		uint64_t bits = random();
+		double value;
+		memcpy(&value, &bits, sizeof(double));
+		if (!std::isfinite(value))
+			continue;
+
+		snprintf(buffer, sizeof(buffer), "%.*g", (int)(i % 17) + 1, value); //Short and long mantissas
+		const double expected = strtod(buffer, nullptr);
+		if (!IsFloat(buffer, expected) && !(expected == std::trunc(expected) && std::fabs(expected) < 9e18)) //Small integral values parse as Int
+			++mismatches;
+	}
+
+	CHECK(mismatches == 0);
+
+	//Decimal strings of every length and exponent range, including subnormals
+	mismatches = 0;
+	for (size_t i = 0; i < 100000; ++i) {
+		std::string number = std::to_string(random() % 10 + 1);
+		const size_t digits = random() % 30;
+		for (size_t j = 0; j < digits; ++j)
+			number += (char)('0' + random() % 10);
+
+		number.insert(1, ".");
+		number += "e" + std::to_string((int)(random() % 700) - 350);
+
+		const double expected = strtod(number.data(), nullptr);
+		if (!IsFloat(number, expected))
+			++mismatches;
+	}
+
+	CHECK(mismatches == 0);
+}
@@ -0,0 +1,104 @@
+#include "Tests.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+//Counts every allocation in the test binary, ParseInto is checked by the difference around a call
+static std::atomic<size_t> allocationCount = 0;
+
+void* operator new(size_t size) {
+	++allocationCount;
+	if (void* pointer = malloc(size == 0 ? 1 : size))
+		return pointer;
+
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { //Used by std::stable_sort's temporary buffer, must pair with the replaced delete
+	++allocationCount;
+	return malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* pointer) noexcept {
+	free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+	free(pointer);
+}
+
+
+static bool SameDocument(const std::unordered_map<std::string, Variant>& a, const std::unordered_map<std::string, Variant>& b) {
+	return JSON::Diff(a, b).empty();
+}
+
+
+TEST(ParseIntoMatchesParseJSON) {
+
+	const char* documents[] = {
+		"{\"a\":1,\"b\":\"text\",\"c\":[1,2.5,\"x\",true,null],\"d\":{\"e\":{\"f\":[{\"g\":1},{\"g\":2}]}}}",
+		"{\"a\":\"now a string\",\"c\":[],\"d\":{\"e\":[1,2,3]},\"new\":{\"k\":false}}", //Changed types, removed and added keys
+		"{}",
+		"{\"a\":[[1,2],[3]],\"b\":{\"a\\\"quoted\\\"\":1},\"b\":2}" //Duplicate keys, last one wins like ParseJSON
+	};
+
+	std::unordered_map<std::string, Variant> map;
+	for (const char* document : documents) {
+		JSON::ParseInto(map, document);
+		CHECK(SameDocument(map, JSON::ParseJSON(document)));
+	}
+}
+
+TEST(ParseIntoReusesStorage) {
+
+	std::unordered_map<std::string, Variant> map;
+	JSON::ParseInto(map, "{\"name\":\"a long enough name to live on the heap\",\"nested\":{\"list\":[1,2,3]}}");
+
+	const std::string* name = (std::string*)map["name"].GetData();
+	const char* nameBuffer = name->data();
+	const Variant* nested = &map["nested"];
+	const void* nestedMap = nested->GetData();
+
+	JSON::ParseInto(map, "{\"name\":\"a shorter name, still on the heap\",\"nested\":{\"list\":[4,5]}}");
+
+	CHECK((std::string*)map["name"].GetData() == name && name->data() == nameBuffer);
+	CHECK(*name == "a shorter name, still on the heap");
+	CHECK(&map["nested"] == nested && nested->GetData() == nestedMap);
+	CHECK(SameDocument(map, JSON::ParseJSON("{\"name\":\"a shorter name, still on the heap\",\"nested\":{\"list\":[4,5]}}")));
+}
+
+TEST(ParseIntoSteadyStateDoesNotAllocate) {
+
+	const std::string first = "{\"frame\":1,\"camera\":{\"position\":[0.5,1.5,2.5],\"name\":\"main camera of the scene\"},\"objects\":[{\"id\":1,\"visible\":true},{\"id\":2,\"visible\":false}]}";
+	const std::string second = "{\"frame\":2,\"camera\":{\"position\":[0.7,1.2,2.9],\"name\":\"side camera of the scene\"},\"objects\":[{\"id\":3,\"visible\":false},{\"id\":4,\"visible\":true}]}";
+
+	std::unordered_map<std::string, Variant> map;
+	size_t before = allocationCount;
+	JSON::ParseInto(map, first);
+	CHECK(allocationCount > before); //New structure
+
+	JSON::ParseInto(map, second); //Warms the per thread buffers
+
+	before = allocationCount;
+	JSON::ParseInto(map, first);
+	JSON::ParseInto(map, second);
+	CHECK(allocationCount == before);
+
+	CHECK(SameDocument(map, JSON::ParseJSON(second)));
+}
+
+TEST(ParseIntoBorrowedData) {
+
+	//A dictionary pointing at a map it doesn't own is replaced, not written through
+	std::unordered_map<std::string, Variant> borrowed = JSON::ParseJSON("{\"x\":1}");
+
+	std::unordered_map<std::string, Variant> map;
+	map["child"] = Variant(&borrowed);
+
+	JSON::ParseInto(map, "{\"child\":{\"x\":2,\"y\":3}}");
+
+	CHECK(borrowed.size() == 1 && (int64_t)borrowed["x"] == 1);
+	CHECK(SameDocument(map, JSON::ParseJSON("{\"child\":{\"x\":2,\"y\":3}}")));
+}
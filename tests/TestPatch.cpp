@@ -0,0 +1,105 @@
+#include "Tests.hpp"
+
+
+static std::vector<Variant> ParsePatch(const std::string& string) { //Wrapped in an object since ParseJSON only returns maps
+	return *(std::vector<Variant>*)JSON::ParseJSON("{\"patch\":" + string + "}")["patch"].GetData();
+}
+
+static bool SameDocument(const std::unordered_map<std::string, Variant>& a, const std::unordered_map<std::string, Variant>& b) {
+	return JSON::Diff(a, b).empty();
+}
+
+
+TEST(PatchDiffRoundTrip) {
+
+	const std::unordered_map<std::string, Variant> from = JSON::ParseJSON("{\"a\":1,\"b\":{\"c\":\"x\",\"d\":[1,\"two\",{\"e\":3}]},\"removed\":true,\"list\":[{\"k\":1},{\"k\":2},{\"k\":3}]}");
+	const std::unordered_map<std::string, Variant> to = JSON::ParseJSON("{\"a\":2,\"b\":{\"c\":\"x\",\"d\":[1,\"three\",{\"e\":3,\"f\":4}]},\"added\":[1,2],\"list\":[{\"k\":1}]}");
+
+	const std::vector<Variant> patch = JSON::Diff(from, to);
+	CHECK(!patch.empty());
+
+	std::unordered_map<std::string, Variant> patched = from;
+	CHECK(JSON::ApplyPatch(patched, patch));
+	CHECK(SameDocument(patched, to));
+}
+
+TEST(PatchDiffIdentical) {
+
+	const std::unordered_map<std::string, Variant> map = JSON::ParseJSON("{\"a\":[1,\"b\",{\"c\":null}],\"d\":1.5}");
+	const std::unordered_map<std::string, Variant> copy = map;
+
+	CHECK(JSON::Diff(map, map).empty()); //Shared storage
+	CHECK(JSON::Diff(map, copy).empty()); //Walked
+}
+
+TEST(PatchDiffNumbers) {
+
+	//1 and 1.0 are the same JSON number
+	CHECK(JSON::Diff(JSON::ParseJSON("{\"a\":1}"), JSON::ParseJSON("{\"a\":1.0}")).empty());
+	CHECK(JSON::Diff(JSON::ParseJSON("{\"a\":1}"), JSON::ParseJSON("{\"a\":1.5}")).size() == 1);
+}
+
+TEST(PatchEscapedPointers) {
+
+	const std::unordered_map<std::string, Variant> from = JSON::ParseJSON("{\"a/b\":1,\"m~n\":2}");
+	const std::unordered_map<std::string, Variant> to = JSON::ParseJSON("{\"a/b\":3,\"m~n\":4}");
+
+	const std::vector<Variant> patch = JSON::Diff(from, to);
+	CHECK(patch.size() == 2);
+	for (const Variant& operation : patch) {
+		const std::string& path = *(std::string*)JSON::Find(operation, "path")->GetData();
+		CHECK(path == "/a~1b" || path == "/m~0n");
+	}
+
+	std::unordered_map<std::string, Variant> patched = from;
+	CHECK(JSON::ApplyPatch(patched, patch));
+	CHECK(SameDocument(patched, to));
+}
+
+TEST(PatchOperations) {
+
+	std::unordered_map<std::string, Variant> map = JSON::ParseJSON("{\"list\":[1,\"a\",true],\"object\":{\"x\":1}}");
+
+	CHECK(JSON::ApplyPatch(map, ParsePatch(
+		"[{\"op\":\"add\",\"path\":\"/list/1\",\"value\":\"inserted\"},"
+		"{\"op\":\"add\",\"path\":\"/list/-\",\"value\":\"last\"},"
+		"{\"op\":\"remove\",\"path\":\"/list/0\"},"
+		"{\"op\":\"copy\",\"from\":\"/object\",\"path\":\"/copied\"},"
+		"{\"op\":\"move\",\"from\":\"/object/x\",\"path\":\"/moved\"},"
+		"{\"op\":\"replace\",\"path\":\"/copied/x\",\"value\":2},"
+		"{\"op\":\"test\",\"path\":\"/moved\",\"value\":1}]")));
+
+	CHECK(SameDocument(map, JSON::ParseJSON("{\"list\":[\"inserted\",\"a\",true,\"last\"],\"object\":{},\"copied\":{\"x\":2},\"moved\":1}")));
+}
+
+TEST(PatchRejectsBadIndices) {
+
+	const std::unordered_map<std::string, Variant> original = JSON::ParseJSON("{\"list\":[1,\"a\",true]}");
+
+	for (const char* path : { "/list/3", "/list/01", "/list/-1", "/list/x", "/list/18446744073709551615", "/list/18446744073709551616", "/list/99999999999999999999999" }) {
+		std::unordered_map<std::string, Variant> map = original;
+		CHECK(!JSON::ApplyPatch(map, ParsePatch(std::string("[{\"op\":\"remove\",\"path\":\"") + path + "\"}]")));
+		CHECK(!JSON::ApplyPatch(map, ParsePatch(std::string("[{\"op\":\"replace\",\"path\":\"") + path + "\",\"value\":0}]")));
+		CHECK(SameDocument(map, original));
+	}
+
+	//Indices past the end can't be added either, only the end itself
+	std::unordered_map<std::string, Variant> map = original;
+	CHECK(!JSON::ApplyPatch(map, ParsePatch("[{\"op\":\"add\",\"path\":\"/list/18446744073709551616\",\"value\":0}]")));
+	CHECK(!JSON::ApplyPatch(map, ParsePatch("[{\"op\":\"add\",\"path\":\"/list/4\",\"value\":0}]")));
+	CHECK(JSON::ApplyPatch(map, ParsePatch("[{\"op\":\"add\",\"path\":\"/list/3\",\"value\":0}]")));
+}
+
+TEST(PatchRejectsInvalidOperations) {
+
+	std::unordered_map<std::string, Variant> map = JSON::ParseJSON("{\"a\":{\"b\":1}}");
+
+	CHECK(!JSON::ApplyPatch(map, ParsePatch("[{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/a/c\"}]"))); //Into its own child
+	CHECK(!JSON::ApplyPatch(map, ParsePatch("[{\"op\":\"test\",\"path\":\"/a/b\",\"value\":2}]")));
+	CHECK(!JSON::ApplyPatch(map, ParsePatch("[{\"op\":\"replace\",\"path\":\"\",\"value\":1}]"))); //Root must stay an object
+	CHECK(!JSON::ApplyPatch(map, ParsePatch("[{\"op\":\"unknown\",\"path\":\"/a\"}]")));
+	CHECK(!JSON::ApplyPatch(map, ParsePatch("[{\"op\":\"add\",\"path\":\"a\",\"value\":1}]"))); //Not a pointer
+	CHECK(!JSON::ApplyPatch(map, ParsePatch("[{\"op\":\"remove\",\"path\":\"/missing/b\"}]")));
+
+	CHECK(SameDocument(map, JSON::ParseJSON("{\"a\":{\"b\":1}}")));
+}
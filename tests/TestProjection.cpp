@@ -0,0 +1,52 @@
+#include "Tests.hpp"
+
+
+static bool Projects(const std::string& json, const std::vector<std::string>& paths, const std::string& expected) {
+	return JSON::Diff(JSON::ParseJSON(json, JSON::Projection(paths)), JSON::ParseJSON(expected)).empty();
+}
+
+static const std::string scene = "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[{\"name\":\"a\",\"mesh\":0,\"translation\":[1,2,3]},{\"name\":\"b\",\"children\":[0]},{\"name\":\"c\",\"mesh\":1}],\"scene\":0}";
+
+
+TEST(ProjectionMembers) {
+
+	CHECK(Projects(scene, { "/scene" }, "{\"scene\":0}"));
+	CHECK(Projects(scene, { "/asset/version", "/scene" }, "{\"asset\":{\"version\":\"2.0\"},\"scene\":0}"));
+	CHECK(Projects(scene, { "/asset" }, "{\"asset\":{\"version\":\"2.0\"}}")); //Whole subtree
+	CHECK(Projects(scene, { "" }, scene)); //Whole document
+	CHECK(Projects(scene, { "/missing", "/asset/missing" }, "{}"));
+}
+
+TEST(ProjectionWildcard) {
+
+	CHECK(Projects(scene, { "/nodes/*/name" }, "{\"nodes\":[{\"name\":\"a\"},{\"name\":\"b\"},{\"name\":\"c\"}]}"));
+	CHECK(Projects(scene, { "/nodes/*/mesh" }, "{\"nodes\":[{\"mesh\":0},{\"mesh\":1}]}")); //Elements without the field are omitted
+	CHECK(Projects(scene, { "/*/version" }, "{\"asset\":{\"version\":\"2.0\"}}"));
+}
+
+TEST(ProjectionArrayIndices) {
+
+	CHECK(Projects(scene, { "/nodes/0/name" }, "{\"nodes\":[{\"name\":\"a\"}]}"));
+	CHECK(Projects(scene, { "/nodes/2" }, "{\"nodes\":[{\"name\":\"c\",\"mesh\":1}]}")); //Packed, the element moves to index 0
+	CHECK(Projects(scene, { "/nodes/0/translation/1", "/nodes/2/name" }, "{\"nodes\":[{\"translation\":[2]},{\"name\":\"c\"}]}"));
+	CHECK(Projects(scene, { "/nodes/3/name", "/nodes/01/name" }, "{}")); //Past the end, and leading zeros aren't indices
+	CHECK(Projects(scene, { "/nodes/1/name", "/nodes/*/mesh" }, "{\"nodes\":[{\"mesh\":0},{\"name\":\"b\"},{\"mesh\":1}]}")); //Index and wildcard together
+	CHECK(Projects("{\"a\":[[1,2],[3,4],[5,6]]}", { "/a/1/0" }, "{\"a\":[[3]]}"));
+	CHECK(Projects("{\"a\":[]}", { "/a/0" }, "{}"));
+}
+
+TEST(ProjectionNumericMemberNames) {
+
+	//Numeric tokens still match object members of that name
+	CHECK(Projects("{\"a\":{\"0\":1,\"1\":2}}", { "/a/1" }, "{\"a\":{\"1\":2}}"));
+}
+
+TEST(ProjectionEscapedPointers) {
+
+	CHECK(Projects("{\"a/b\":1,\"c~d\":2,\"e\":3}", { "/a~1b", "/c~0d" }, "{\"a/b\":1,\"c~d\":2}"));
+}
+
+TEST(ProjectionScalarWhereContainerExpected) {
+
+	CHECK(Projects("{\"a\":1,\"b\":\"x\",\"c\":{\"d\":2}}", { "/a/d", "/b/0", "/c/d" }, "{\"c\":{\"d\":2}}"));
+}
@@ -0,0 +1,188 @@
+#include "Tests.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+class StringSource : public JSON::Source { //Hands out at most readSize bytes per call, exercising window refills
+
+public:
+
+	StringSource(const std::string& pContents, size_t pReadSize) : contents(pContents), readSize(pReadSize) {}
+
+	size_t Read(char* data, size_t size) override {
+		const size_t count = std::min({ size, readSize, contents.size() - offset });
+		memcpy(data, contents.data() + offset, count);
+		offset += count;
+		return count;
+	}
+
+private:
+
+	std::string contents;
+	size_t readSize;
+	size_t offset = 0;
+};
+
+
+static std::vector<Variant> ReadAll(JSON::ArrayReader& reader) {
+
+	std::vector<Variant> elements;
+	Variant element;
+	while (reader.Next(element))
+		elements.push_back(element);
+
+	return elements;
+}
+
+static std::string MakeArray(size_t count) { //Mixed elements, some containers
+
+	std::string array = "[";
+	for (size_t i = 0; i < count; ++i) {
+		if (i > 0)
+			array += ",\n ";
+
+		if (i % 3 == 0)
+			array += std::to_string(i);
+		else if (i % 3 == 1)
+			array += "\"s" + std::to_string(i) + "\"";
+		else
+			array += "{\"i\":" + std::to_string(i) + ",\"a\":[1,2,{\"b\":null}]}";
+	}
+
+	return array + "]";
+}
+
+static bool SameElements(const std::vector<Variant>& elements, const std::string& array) { //Against ParseJSON of the same array
+
+	std::unordered_map<std::string, Variant> expected = JSON::ParseJSON("{\"array\":" + array + "}");
+	std::unordered_map<std::string, Variant> read;
+	read["array"] = elements;
+
+	return JSON::Diff(expected, read).empty();
+}
+
+
+TEST(ReaderArrayFromBuffer) {
+
+	const std::string array = MakeArray(100);
+	JSON::ArrayReader reader(array);
+
+	const std::vector<Variant> elements = ReadAll(reader);
+	CHECK(elements.size() == 100);
+	CHECK(SameElements(elements, array));
+
+	Variant element;
+	CHECK(!reader.Next(element)); //Stays finished
+}
+
+TEST(ReaderArrayFromSource) {
+
+	const std::string array = MakeArray(20000); //Several chunks
+
+	for (const size_t readSize : { (size_t)7, (size_t)4096, (size_t)1 << 20 }) {
+		JSON::ArrayReader reader(std::make_unique<StringSource>(array, readSize));
+		CHECK(SameElements(ReadAll(reader), array));
+	}
+
+	const std::string small = MakeArray(300); //Byte at a time
+	JSON::ArrayReader reader(std::make_unique<StringSource>(small, 1));
+	CHECK(SameElements(ReadAll(reader), small));
+}
+
+TEST(ReaderElementBiggerThanChunk) {
+
+	const std::string big(300 * 1024, 'x');
+	const std::string array = "[1,\"" + big + "\",{\"big\":\"" + big + "\"},2]";
+
+	JSON::ArrayReader reader(std::make_unique<StringSource>(array, 1000));
+	const std::vector<Variant> elements = ReadAll(reader);
+	CHECK(elements.size() == 4);
+	CHECK(SameElements(elements, array));
+}
+
+TEST(ReaderArrayFromFile) {
+
+	const std::string array = MakeArray(5000);
+	const std::string path = GetTestPath("reader.json");
+	WriteTestFile(path, array);
+
+	JSON::ArrayReader reader = JSON::ArrayReader::FromFile(path);
+	CHECK(SameElements(ReadAll(reader), array));
+
+	JSON::ArrayReader missing = JSON::ArrayReader::FromFile(GetTestPath("missing.json"));
+	Variant element;
+	CHECK(!missing.Next(element));
+}
+
+TEST(ReaderObject) {
+
+	const std::string object = " {\"a\":1, \"b\" : [1,2], \"c\":{\"d\":\"e\"}, \"q\\\"k\":null}";
+
+	for (const size_t readSize : { (size_t)1, (size_t)4096 }) {
+		JSON::ObjectReader reader(std::make_unique<StringSource>(object, readSize));
+
+		std::unordered_map<std::string, Variant> read;
+		std::string key;
+		Variant value;
+		while (reader.Next(key, value))
+			read[key] = value;
+
+		CHECK(read.size() == 4);
+		CHECK(read.count("q\"k") == 1);
+		CHECK(JSON::Diff(read, JSON::ParseJSON(object)).empty());
+	}
+}
+
+TEST(ReaderEmptyAndWrongContainers) {
+
+	Variant element;
+	std::string key;
+
+	JSON::ArrayReader empty(std::string_view("  [ ]"));
+	CHECK(!empty.Next(element));
+
+	JSON::ArrayReader object(std::string_view("{\"a\":1}"));
+	CHECK(!object.Next(element));
+
+	JSON::ObjectReader array(std::string_view("[1,2]"));
+	CHECK(!array.Next(key, element));
+
+	JSON::ArrayReader nothing(std::string_view(""));
+	CHECK(!nothing.Next(element));
+}
+
+TEST(ReaderMalformed) {
+
+	Variant element;
+	std::string key;
+
+	JSON::ArrayReader truncated(std::string_view("[1,2"));
+	CHECK(truncated.Next(element) && (int64_t)element == 1);
+	CHECK(truncated.Next(element) && (int64_t)element == 2);
+	CHECK(!truncated.Next(element));
+
+	JSON::ObjectReader unquoted(std::string_view("{a:1}"));
+	CHECK(!unquoted.Next(key, element));
+
+	JSON::ObjectReader noValue(std::string_view("{\"a\":1,\"b\":"));
+	CHECK(noValue.Next(key, element) && key == "a");
+	CHECK(!noValue.Next(key, element));
+}
+
+TEST(ReaderMovedFrom) {
+
+	const std::string array = "[1,2,3]";
+	JSON::ArrayReader reader(array);
+
+	Variant element;
+	CHECK(reader.Next(element) && (int64_t)element == 1);
+
+	JSON::ArrayReader moved = std::move(reader);
+	CHECK(!reader.Next(element)); //Moved from readers are empty
+	CHECK(moved.Next(element) && (int64_t)element == 2);
+
+	reader = std::move(moved);
+	CHECK(reader.Next(element) && (int64_t)element == 3);
+	CHECK(!reader.Next(element));
+}
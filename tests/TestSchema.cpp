@@ -0,0 +1,151 @@
+#include "Tests.hpp"
+
+
+static bool Conforms(const std::string& schema, const std::string& document, std::unordered_map<std::string, Variant>& map, size_t& errorOffset) {
+	return JSON::ParseJSON(document, JSON::Schema(JSON::ParseJSON(schema)), map, errorOffset);
+}
+
+static bool Conforms(const std::string& schema, const std::string& document) {
+	std::unordered_map<std::string, Variant> map;
+	size_t errorOffset;
+	return Conforms(schema, document, map, errorOffset);
+}
+
+static std::string Property(const std::string& schema) { //Schema of a document with a single "v" member
+	return "{\"type\":\"object\",\"properties\":{\"v\":" + schema + "}}";
+}
+
+
+TEST(SchemaTypes) {
+
+	CHECK(Conforms(Property("{\"type\":\"string\"}"), "{\"v\":\"x\"}"));
+	CHECK(!Conforms(Property("{\"type\":\"string\"}"), "{\"v\":1}"));
+	CHECK(Conforms(Property("{\"type\":\"boolean\"}"), "{\"v\":false}"));
+	CHECK(Conforms(Property("{\"type\":\"null\"}"), "{\"v\":null}"));
+	CHECK(!Conforms(Property("{\"type\":\"null\"}"), "{\"v\":0}"));
+	CHECK(Conforms(Property("{\"type\":[\"string\",\"null\"]}"), "{\"v\":null}"));
+	CHECK(Conforms(Property("{\"type\":\"object\"}"), "{\"v\":{\"a\":1}}"));
+	CHECK(!Conforms(Property("{\"type\":\"object\"}"), "{\"v\":[1]}"));
+	CHECK(!Conforms(Property("{\"type\":\"array\"}"), "{\"v\":{}}"));
+	CHECK(Conforms(Property("{}"), "{\"v\":[1,{\"a\":null}]}")); //No type accepts anything
+	CHECK(Conforms(Property("{\"type\":\"string\"}"), "{\"other\":1}")); //Unlisted properties aren't checked
+
+	CHECK(!Conforms("{\"type\":\"array\"}", "{}")); //Documents are objects
+}
+
+TEST(SchemaNumbers) {
+
+	std::unordered_map<std::string, Variant> map;
+	size_t errorOffset;
+
+	CHECK(Conforms(Property("{\"type\":\"number\"}"), "{\"v\":3}", map, errorOffset));
+	CHECK(map["v"].GetType() == Variant::Float && (double)map["v"] == 3.0); //Plain numbers are stored as Float
+
+	CHECK(Conforms(Property("{\"type\":\"integer\"}"), "{\"v\":2.0}", map, errorOffset));
+	CHECK(map["v"].GetType() == Variant::Int && (int64_t)map["v"] == 2); //1.0 is an integer in JSON Schema
+
+	CHECK(!Conforms(Property("{\"type\":\"integer\"}"), "{\"v\":2.5}"));
+	CHECK(!Conforms(Property("{\"type\":\"integer\"}"), "{\"v\":1e300}"));
+	CHECK(Conforms(Property("{\"type\":[\"integer\",\"number\"]}"), "{\"v\":2.5}"));
+}
+
+TEST(SchemaBounds) {
+
+	const std::string inclusive = Property("{\"type\":\"number\",\"minimum\":0,\"maximum\":10}");
+	CHECK(Conforms(inclusive, "{\"v\":0}"));
+	CHECK(Conforms(inclusive, "{\"v\":10}"));
+	CHECK(!Conforms(inclusive, "{\"v\":-0.5}"));
+	CHECK(!Conforms(inclusive, "{\"v\":10.5}"));
+
+	//Draft 4 booleans make minimum and maximum exclusive
+	const std::string draft4 = Property("{\"type\":\"number\",\"minimum\":0,\"exclusiveMinimum\":true,\"maximum\":10,\"exclusiveMaximum\":true}");
+	CHECK(!Conforms(draft4, "{\"v\":0}"));
+	CHECK(!Conforms(draft4, "{\"v\":10}"));
+	CHECK(Conforms(draft4, "{\"v\":5}"));
+
+	CHECK(Conforms(Property("{\"minimum\":0,\"exclusiveMinimum\":false}"), "{\"v\":0}"));
+	CHECK(Conforms(Property("{\"exclusiveMinimum\":true}"), "{\"v\":-100}")); //Without minimum there's nothing to make exclusive
+
+	//Later drafts give numeric bounds, the stricter of them and minimum/maximum applies
+	const std::string draft6 = Property("{\"type\":\"number\",\"exclusiveMinimum\":1,\"exclusiveMaximum\":5}");
+	CHECK(!Conforms(draft6, "{\"v\":1}"));
+	CHECK(Conforms(draft6, "{\"v\":1.5}"));
+	CHECK(!Conforms(draft6, "{\"v\":5}"));
+
+	CHECK(!Conforms(Property("{\"minimum\":3,\"exclusiveMinimum\":1}"), "{\"v\":2}"));
+	CHECK(!Conforms(Property("{\"minimum\":1,\"exclusiveMinimum\":3}"), "{\"v\":3}"));
+	CHECK(Conforms(Property("{\"minimum\":1,\"exclusiveMinimum\":3}"), "{\"v\":3.5}"));
+
+	CHECK(Conforms(Property("{\"maximum\":0}"), "{\"v\":\"strings ignore bounds\"}"));
+}
+
+TEST(SchemaEnum) {
+
+	const std::string schema = Property("{\"enum\":[\"red\",\"green\",1,null]}");
+	CHECK(Conforms(schema, "{\"v\":\"green\"}"));
+	CHECK(Conforms(schema, "{\"v\":1}"));
+	CHECK(Conforms(schema, "{\"v\":null}"));
+	CHECK(!Conforms(schema, "{\"v\":\"blue\"}"));
+	CHECK(!Conforms(schema, "{\"v\":2}"));
+
+	CHECK(Conforms("{\"enum\":[{\"a\":1}]}", "{\"a\":1}")); //On the whole document
+	CHECK(!Conforms("{\"enum\":[{\"a\":1}]}", "{\"a\":2}"));
+}
+
+TEST(SchemaRequired) {
+
+	const std::string schema = "{\"type\":\"object\",\"required\":[\"a\",\"b\"],\"properties\":{\"c\":{\"type\":\"object\",\"required\":[\"d\"]}}}";
+	CHECK(Conforms(schema, "{\"a\":1,\"b\":null}"));
+	CHECK(!Conforms(schema, "{\"a\":1}"));
+	CHECK(Conforms(schema, "{\"a\":1,\"b\":2,\"c\":{\"d\":3}}"));
+	CHECK(!Conforms(schema, "{\"a\":1,\"b\":2,\"c\":{\"e\":3}}"));
+}
+
+TEST(SchemaItemsPacked) {
+
+	std::unordered_map<std::string, Variant> map;
+	size_t errorOffset;
+
+	CHECK(Conforms(Property("{\"type\":\"array\",\"items\":{\"type\":\"integer\"}}"), "{\"v\":[1,2,3.0]}", map, errorOffset));
+	CHECK(map["v"].GetType() == Variant::IntArray && ((std::vector<int64_t>*)map["v"].GetData())->size() == 3);
+
+	CHECK(Conforms(Property("{\"type\":\"array\",\"items\":{\"type\":\"number\"}}"), "{\"v\":[1,2.5]}", map, errorOffset));
+	CHECK(map["v"].GetType() == Variant::FloatArray && (*(std::vector<double>*)map["v"].GetData())[0] == 1.0);
+
+	CHECK(Conforms(Property("{\"type\":\"array\",\"items\":{\"type\":\"string\"}}"), "{\"v\":[\"a\",\"b\"]}", map, errorOffset));
+	CHECK(map["v"].GetType() == Variant::StringArray && (*(std::vector<std::string>*)map["v"].GetData())[1] == "b");
+
+	CHECK(Conforms(Property("{\"type\":\"array\",\"items\":{\"type\":\"boolean\"}}"), "{\"v\":[true,false]}", map, errorOffset));
+	CHECK(map["v"].GetType() == Variant::BoolArray);
+
+	CHECK(Conforms(Property("{\"type\":\"array\",\"items\":{\"enum\":[1,2]}}"), "{\"v\":[1,2]}", map, errorOffset));
+	CHECK(map["v"].GetType() == Variant::VariantArray); //Enums stay variants
+
+	CHECK(Conforms(Property("{\"type\":\"array\",\"items\":{\"type\":\"object\",\"required\":[\"k\"]}}"), "{\"v\":[{\"k\":1},{\"k\":2}]}", map, errorOffset));
+	CHECK(map["v"].GetType() == Variant::VariantArray);
+
+	CHECK(!Conforms(Property("{\"type\":\"array\",\"items\":{\"type\":\"integer\"}}"), "{\"v\":[1,\"2\"]}"));
+	CHECK(!Conforms(Property("{\"type\":\"array\",\"items\":{\"type\":\"object\",\"required\":[\"k\"]}}"), "{\"v\":[{\"k\":1},{}]}"));
+	CHECK(!Conforms(Property("{\"items\":{\"type\":\"integer\",\"maximum\":5}}"), "{\"v\":[1,6]}"));
+}
+
+TEST(SchemaPackedRoundTrip) {
+
+	std::unordered_map<std::string, Variant> map;
+	size_t errorOffset;
+	CHECK(Conforms("{\"properties\":{\"i\":{\"items\":{\"type\":\"integer\"}},\"s\":{\"items\":{\"type\":\"string\"}}}}", "{\"i\":[1,-2],\"s\":[\"x\"]}", map, errorOffset));
+
+	map["bytes"] = std::vector<uint8_t>({ 0, 7, 255 });
+	const std::unordered_map<std::string, Variant> written = JSON::ParseJSON(JSON::ToJSON(map));
+	CHECK(JSON::Diff(written, JSON::ParseJSON("{\"i\":[1,-2],\"s\":[\"x\"],\"bytes\":[0,7,255]}")).empty());
+}
+
+TEST(SchemaErrorOffset) {
+
+	std::unordered_map<std::string, Variant> map;
+	size_t errorOffset = SIZE_MAX;
+
+	const std::string document = "{\"a\":1,\"v\":\"wrong\",\"b\":2}";
+	CHECK(!Conforms(Property("{\"type\":\"integer\"}"), document, map, errorOffset));
+	CHECK(errorOffset > document.find("\"v\"") && errorOffset <= document.find(",\"b\"")); //Stops at the violation
+}
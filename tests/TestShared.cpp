@@ -0,0 +1,101 @@
+#include "Tests.hpp"
+
+#include "JSONShared.hpp"
+
+#include <thread>
+
+
+TEST(SharedSnapshotOutlivesPublish) {
+
+	JSON::SharedDocument document(JSON::ParseJSON("{\"version\":1}"));
+
+	JSON::SharedDocument::Snapshot old = document.GetSnapshot();
+	document.Publish(JSON::ParseJSON("{\"version\":2}"));
+	JSON::SharedDocument::Snapshot latest = document.GetSnapshot();
+
+	CHECK((int64_t)old->at("version") == 1); //Still alive, held back from reclamation
+	CHECK((int64_t)latest->at("version") == 2);
+}
+
+TEST(SharedMoreSnapshotsThanSlots) {
+
+	//Past JSON_SHARED_DOCUMENT_SLOTS snapshots fall back to pinning instead of waiting for a slot
+	JSON::SharedDocument document(JSON::ParseJSON("{\"version\":1}"));
+
+	std::vector<JSON::SharedDocument::Snapshot> snapshots;
+	for (size_t i = 0; i < JSON_SHARED_DOCUMENT_SLOTS * 2; ++i)
+		snapshots.push_back(document.GetSnapshot());
+
+	document.Publish(JSON::ParseJSON("{\"version\":2}"));
+
+	bool allOld = true;
+	for (const JSON::SharedDocument::Snapshot& snapshot : snapshots)
+		allOld = allOld && (int64_t)snapshot->at("version") == 1;
+
+	CHECK(allOld);
+
+	snapshots.clear();
+	document.Publish(JSON::ParseJSON("{\"version\":3}")); //Reclaims the unpinned documents
+	CHECK((int64_t)document.GetSnapshot()->at("version") == 3);
+}
+
+TEST(SharedReloads) {
+
+	JSON::SharedDocument document;
+	CHECK(document.GetSnapshot()->empty());
+
+	document.Reload("{\"a\":1}");
+	CHECK((int64_t)document.GetSnapshot()->at("a") == 1);
+
+	document.ReloadAsync("{\"a\":2}").wait();
+	CHECK((int64_t)document.GetSnapshot()->at("a") == 2);
+
+	//Left running, the destructor waits for them before freeing the document they publish into
+	JSON::SharedDocument* pending = new JSON::SharedDocument();
+	for (int i = 0; i < 8; ++i)
+		pending->ReloadAsync("{\"a\":" + std::to_string(i) + "}");
+
+	delete pending;
+}
+
+TEST(SharedConcurrentReaders) {
+
+	//Readers must always see a whole document, never a mix of two publishes or a freed one
+	JSON::SharedDocument document(JSON::ParseJSON("{\"a\":0,\"b\":0}"));
+
+	std::atomic<bool> stop = false;
+	std::atomic<size_t> torn = 0;
+	std::atomic<size_t> reads = 0;
+
+	std::vector<std::thread> readers;
+	for (int i = 0; i < 4; ++i) {
+		readers.emplace_back([&]() {
+			int64_t last = 0;
+			while (!stop) {
+				JSON::SharedDocument::Snapshot snapshot = document.GetSnapshot();
+				const int64_t a = snapshot->at("a");
+				if (a != (int64_t)snapshot->at("b") || a < last) //Torn or went back in time
+					++torn;
+
+				last = a;
+				++reads;
+			}
+		});
+	}
+
+	for (int64_t i = 1; i <= 2000; ++i) {
+		document.Publish(JSON::ParseJSON("{\"a\":" + std::to_string(i) + ",\"b\":" + std::to_string(i) + "}"));
+		if (i % 50 == 0) //Lets readers in between publishes on few cores
+			std::this_thread::yield();
+	}
+
+	while (reads < 1000)
+		std::this_thread::yield();
+
+	stop = true;
+	for (std::thread& reader : readers)
+		reader.join();
+
+	CHECK(torn == 0);
+	CHECK((int64_t)document.GetSnapshot()->at("a") == 2000);
+}
@@ -0,0 +1,82 @@
+#include "Tests.hpp"
+
+
+TEST(TapeNavigation) {
+
+	const JSON::Tape tape = JSON::ParseTape("{\"name\":\"neon\",\"count\":3,\"ratio\":0.5,\"flags\":[true,false,null],\"nested\":{\"list\":[1,[2,3],{\"a\":4}],\"empty\":{}},\"last\":-7}");
+	const JSON::Tape::Value root = tape.GetRoot();
+
+	CHECK(root.GetType() == Variant::Dictionary);
+	CHECK(root.Size() == 6);
+	CHECK(root.Find("name").GetString() == "neon");
+	CHECK(root.Find("count").GetInt() == 3);
+	CHECK(root.Find("ratio").GetFloat() == 0.5);
+	CHECK(root.Find("last").GetInt() == -7); //Found after skipping the nested subtrees
+	CHECK(!root.Find("missing").IsValid());
+
+	const JSON::Tape::Value flags = root.Find("flags");
+	CHECK(flags.Size() == 3);
+	CHECK(flags[0].GetBool() && !flags[1].GetBool() && flags[2].IsNull());
+	CHECK(!flags[3].IsValid());
+
+	const JSON::Tape::Value list = root.Find("nested").Find("list");
+	CHECK(list.Size() == 3);
+	CHECK(list[1].Size() == 2 && list[1][1].GetInt() == 3);
+	CHECK(list[2].Find("a").GetInt() == 4);
+	CHECK(root.Find("nested").Find("empty").Size() == 0);
+
+	size_t members = 0;
+	for (auto it = root.begin(); it != root.end(); ++it)
+		++members;
+
+	CHECK(members == 6);
+}
+
+TEST(TapeStrings) {
+
+	const JSON::Tape tape = JSON::ParseTape("[\"\",\"a\\\"b\",\"\xC3\xA9\",\"two words\"]"); //Unescaped like ParseJSON, which only handles \"
+	const JSON::Tape::Value root = tape.GetRoot();
+
+	CHECK(root.Size() == 4);
+	CHECK(root[0].GetString().empty());
+	CHECK(root[1].GetString() == "a\"b");
+	CHECK(root[2].GetString() == "\xC3\xA9");
+	CHECK(root[3].GetString() == "two words");
+	CHECK(root[3].GetInt() == 0); //Not a number
+}
+
+TEST(TapeLargeContainers) {
+
+	//Counts and end indices are stored whole, past the 24 and 32 bits that used to be packed together
+	std::string string = "[";
+	for (size_t i = 0; i < 70000; ++i)
+		string += i == 0 ? "[1,2]" : ",[1,2]";
+
+	string += "]";
+
+	const JSON::Tape tape = JSON::ParseTape(string);
+	const JSON::Tape::Value root = tape.GetRoot();
+	CHECK(root.Size() == 70000);
+	CHECK(root[69999].Size() == 2 && root[69999][1].GetInt() == 2);
+}
+
+TEST(TapeToVariant) {
+
+	const std::string string = "{\"a\":[1,\"two\",3.5,{\"b\":null}],\"c\":{\"d\":true}}";
+	const Variant variant = JSON::ParseTape(string).GetRoot().ToVariant();
+
+	CHECK(variant.GetType() == Variant::Dictionary);
+	CHECK(JSON::Diff(*(std::unordered_map<std::string, Variant>*)variant.GetData(), JSON::ParseJSON(string)).empty());
+}
+
+TEST(TapeMalformed) {
+
+	CHECK(!JSON::ParseTape("").GetRoot().IsValid());
+	CHECK(JSON::ParseTape("42").GetRoot().GetInt() == 42); //Any value can be the root
+
+	//Truncated documents are closed so navigation stays in bounds
+	const JSON::Tape tape = JSON::ParseTape("{\"a\":[1,2,{\"b\":3");
+	const JSON::Tape::Value a = tape.GetRoot().Find("a");
+	CHECK(a.Size() == 3);
+	CHECK(a[2].Find("b").GetInt() == 3);
+}
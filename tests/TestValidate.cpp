@@ -0,0 +1,84 @@
+#include "Tests.hpp"
+
+
+static bool ValidAt(const std::string& string, size_t expectedOffset) { //Invalid with the first error at expectedOffset
+	size_t errorOffset = SIZE_MAX;
+	return !JSON::Validate(string, errorOffset) && errorOffset == expectedOffset;
+}
+
+
+TEST(ValidateAccepts) {
+
+	for (const char* string : { "{}", "[]", "0", "-0", "1.5e-3", "-12E+4", "\"\"", "true", "false", "null", " \t\r\n{ \"a\" : [ 1 , { } , [ ] , \"\\u00e9\\n\" ] } \n",
+		"{\"a\":{\"b\":{\"c\":[true,false,null]}}}", "\"\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\"", "[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"]" }) {
+		CHECK(JSON::Validate(string));
+	}
+
+	//Long inputs cross the 16 byte vector loops of string scanning
+	CHECK(JSON::Validate("[\"" + std::string(1000, 'a') + "\xC3\xA9" + std::string(37, 'b') + "\"]"));
+}
+
+TEST(ValidateErrorOffsets) {
+
+	CHECK(ValidAt("", 0));
+	CHECK(ValidAt("   ", 3));
+	CHECK(ValidAt("x{}", 0)); //Leading garbage isn't skipped
+	CHECK(ValidAt("{} x", 3)); //Trailing data
+	CHECK(ValidAt("{\"a\":1,}", 7)); //Trailing comma
+	CHECK(ValidAt("[1,]", 3));
+	CHECK(ValidAt("{\"a\" 1}", 5)); //Missing colon
+	CHECK(ValidAt("{1:2}", 1)); //Keys must be strings
+	CHECK(ValidAt("[1 2]", 3));
+	CHECK(ValidAt("[1}", 2)); //Mismatched close
+	CHECK(ValidAt("[1", 2)); //Unterminated
+	CHECK(ValidAt("\"abc", 4));
+	CHECK(ValidAt("tru", 0));
+	CHECK(ValidAt("nul1", 0)); //Literals are reported at their start
+}
+
+TEST(ValidateNumbers) {
+
+	CHECK(ValidAt("01", 1)); //Leading zero, "0" then trailing data
+	CHECK(ValidAt("-", 1));
+	CHECK(ValidAt("1.", 2));
+	CHECK(ValidAt(".5", 0));
+	CHECK(ValidAt("1e", 2));
+	CHECK(ValidAt("1e+", 3));
+	CHECK(ValidAt("+1", 0));
+	CHECK(ValidAt("[1.5.5]", 4));
+}
+
+TEST(ValidateStrings) {
+
+	CHECK(ValidAt("\"a\x01\"", 2)); //Raw control character
+	CHECK(ValidAt("\"\\x\"", 2)); //Unknown escape
+	CHECK(ValidAt("\"\\u12G4\"", 5));
+	CHECK(ValidAt("[\"" + std::string(40, 'a') + "\n\"]", 42)); //Found by the vector loop
+}
+
+TEST(ValidateUTF8) {
+
+	CHECK(ValidAt("\"\xC0\xAF\"", 1)); //Overlong
+	CHECK(ValidAt("\"\xE0\x80\xAF\"", 1)); //Overlong 3 bytes
+	CHECK(ValidAt("\"\xED\xA0\x80\"", 1)); //Surrogate
+	CHECK(ValidAt("\"\xF4\x90\x80\x80\"", 1)); //Past U+10FFFF
+	CHECK(ValidAt("\"\xC3\"", 1)); //Truncated
+	CHECK(ValidAt("\"\xE2\x82\x41\"", 1)); //Bad continuation
+	CHECK(ValidAt("\"\x80\"", 1)); //Lone continuation
+	CHECK(ValidAt("\"\xFF\"", 1));
+}
+
+TEST(ValidateDepthLimit) {
+
+	//JSON_VALIDATE_MAX_DEPTH (1024 by default) open containers are accepted, one more is an error at its first element
+	const size_t limit = 1024;
+
+	const std::string deepest = std::string(limit, '[') + "1" + std::string(limit, ']');
+	CHECK(JSON::Validate(deepest));
+
+	const std::string tooDeep = std::string(limit + 1, '[') + "1" + std::string(limit + 1, ']');
+	CHECK(ValidAt(tooDeep, limit + 1));
+
+	//Empty containers don't take a level
+	CHECK(JSON::Validate(std::string(limit, '[') + "[]" + std::string(limit, ']')));
+}
@@ -0,0 +1,51 @@
+//Minimal test harness, every tests/Test*.cpp registers its cases and tests/Main.cpp runs them all. Build and run from the repository root with:
+//g++ -std=c++17 -I. tests/*.cpp *.cpp -lpthread -o Tests && ./Tests
+
+#pragma once
+
+#include "JSON.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+
+struct TestCase {
+	const char* name;
+	void (*function)();
+};
+
+std::vector<TestCase>& GetTestCases();
+extern size_t testFailures;
+
+struct TestRegistrar {
+	TestRegistrar(const char* name, void (*function)()) {
+		GetTestCases().push_back({ name, function });
+	}
+};
+
+#define TEST(name)\
+static void name();\
+static TestRegistrar name##Registrar(#name, name);\
+static void name()
+
+#define CHECK(condition)\
+do {\
+	if (!(condition)) {\
+		printf("  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);\
+		++testFailures;\
+	}\
+} while (false)
+
+
+static inline std::string GetTestPath(const std::string& name) { //Inside a scratch directory removed after the run
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "NeonJSONTests";
+	std::filesystem::create_directories(directory);
+	return (directory / name).string();
+}
+
+static inline void WriteTestFile(const std::string& path, const std::string& contents) {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(contents.data(), contents.size());
+}